@@ -0,0 +1,75 @@
+/* ---- Allocation Benchmark ---------------------------------------------------
+ *
+ *  Allocation throughput of the collector with 1, 2, 4 and 8 threads, each
+ *  allocating short-lived objects of the sizes of pairs and small vectors.
+ *  Build the allocation-benchmark target and run it without arguments.
+ *
+ * -------------------------------------------------------------------------- */
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <meevax/memory/collector.hpp>
+
+namespace
+{
+  template <std::size_t N>
+  struct object
+  {
+    std::uintptr_t words[N];
+  };
+
+  template <std::size_t N>
+  void allocate(meevax::collector & gc)
+  {
+    auto const p = new (gc) object<N>();
+
+    meevax::collector::reset(p, meevax::deallocator<object<N>>::deallocate);
+  }
+
+  void run(std::size_t const objects)
+  {
+    for (std::size_t i = 0; i < objects; i += 4)
+    {
+      allocate<2>(meevax::gc);
+      allocate<2>(meevax::gc);
+      allocate<4>(meevax::gc);
+      allocate<8>(meevax::gc);
+    }
+  }
+} // namespace
+
+auto main() -> int
+{
+  constexpr std::size_t objects = 4 * 1024 * 1024; // per thread
+
+  for (std::size_t threads = 1; threads <= 8; threads *= 2)
+  {
+    auto const start = std::chrono::steady_clock::now();
+
+    if (meevax::collector::safe_region const region; true)
+    {
+      std::vector<std::thread> workers;
+
+      for (std::size_t i = 0; i < threads; ++i)
+      {
+        workers.emplace_back(run, objects);
+      }
+
+      for (auto & worker : workers)
+      {
+        worker.join();
+      }
+    }
+
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "  " << threads << " thread(s): "
+              << static_cast<std::size_t>(threads * objects / elapsed / 1000000) << " M allocations/sec ("
+              << elapsed * 1000 << " msec)" << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+/* ---- Evaluator Benchmark ----------------------------------------------------
+ *
+ *  Two syntactic continuations, each on a thread of its own, evaluating the
+ *  same program at the same time. They share the collector and the symbol
+ *  table, and the program allocates enough to trigger collections while both
+ *  are running. Exits with failure if either evaluator gets a wrong result,
+ *  so it is also run as a test.
+ *
+ * -------------------------------------------------------------------------- */
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <meevax/kernel/syntactic_continuation.hpp>
+
+namespace
+{
+  std::atomic<std::size_t> failures = 0;
+
+  void run(std::size_t const id, std::size_t const rounds)
+  {
+    auto root = meevax::syntactic_continuation(meevax::layer<4>());
+
+    root.evaluate(root.read("(define (fib n) (if (< n 2) n (+ (fib (- n 1)) (fib (- n 2)))))"));
+
+    root.evaluate(root.read("(define (build n) (let loop ((i 0) (xs '())) (if (< i n) (loop (+ i 1) (cons (list i (string->symbol (string-append \"s\" (number->string i)))) xs)) xs)))"));
+
+    root.evaluate(root.read("(define e (make-ephemeron (list 'key) 'datum))"));
+
+    for (std::size_t i = 0; i < rounds; ++i)
+    {
+      auto const expression = "(and (= (fib 18) 2584) (= (length (reverse (build 10000))) 10000) (eq? (cadr (car (build 1))) 's0) (= (string-length (symbol->string (string->symbol \"t" + std::to_string(id) + "-" + std::to_string(i) + "\"))) " + std::to_string(2 + std::to_string(id).size() + std::to_string(i).size()) + "))";
+
+      if (root.evaluate(root.read(expression)) != meevax::t)
+      {
+        ++failures;
+      }
+    }
+
+    if (root.evaluate(root.read("(begin (gc-collect) (ephemeron-broken? e))")) != meevax::t)
+    {
+      ++failures;
+    }
+  }
+} // namespace
+
+auto main() -> int
+{
+  constexpr std::size_t evaluators = 2;
+
+  constexpr std::size_t rounds = 20;
+
+  auto const start = std::chrono::steady_clock::now();
+
+  if (meevax::collector::safe_region const region; true)
+  {
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < evaluators; ++i)
+    {
+      threads.emplace_back(run, i, rounds);
+    }
+
+    for (auto & thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << "  " << evaluators << " evaluators: " << elapsed * 1000 << " msec, " << failures << " failure(s)" << std::endl;
+
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -7,12 +7,12 @@ namespace meevax
 {
 inline namespace functional
 {
-  auto i = [](auto&& x) constexpr
+  inline auto i = [](auto&& x) constexpr
   {
     return std::forward<decltype(x)>(x);
   };
 
-  auto y = [](auto&& f) constexpr
+  inline auto y = [](auto&& f) constexpr
     -> decltype(auto)
   {
     return [&](auto&&... xs)
@@ -22,7 +22,7 @@ inline namespace functional
     };
   };
 
-  auto z = [](auto&& f) constexpr
+  inline auto z = [](auto&& f) constexpr
     -> decltype(auto)
   {
     return
@@ -8,7 +8,7 @@ namespace meevax
 {
 inline namespace functional
 {
-  auto compose = [](auto&& f, auto&& g)
+  inline auto compose = [](auto&& f, auto&& g)
   {
     return [fs = std::forward_as_tuple(f, g)](auto&&... xs) constexpr -> decltype(auto)
     {
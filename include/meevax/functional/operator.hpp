@@ -8,7 +8,7 @@
 
 namespace meevax
 {
-  auto decrement = overload([](auto&& x) constexpr
+  inline auto decrement = overload([](auto&& x) constexpr
   {
     return --x;
   });
@@ -0,0 +1,188 @@
+#ifndef INCLUDED_MEEVAX_KERNEL_CODE_HPP
+#define INCLUDED_MEEVAX_KERNEL_CODE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include <meevax/kernel/instruction.hpp>
+#include <meevax/kernel/list.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  /* ---- Code -----------------------------------------------------------------
+   *
+   *  Compiled code is a contiguous sequence of words, each of which is either
+   *  an opcode or an inline operand, and a constant pool for the operands
+   *  that are objects. The compiler produces instruction lists, and assemble
+   *  flattens them into code:
+   *
+   *    (LOAD-CONSTANT x . C)              LOAD_CONSTANT k      C
+   *    (LOAD-LOCAL (i . j) . C)           LOAD_LOCAL i j       C
+   *    (LOAD-CLOSURE formals body . C)    LOAD_CLOSURE k       C
+   *    (LOAD-CONTINUATION C' . C)         LOAD_CONTINUATION l  C
+   *    (SELECT consequent alternate . C)  SELECT l l'          C
+   *    (CALL n . C)                       CALL n m             C
+   *
+   *  where k is the index of an object in the constant pool (for a closure
+   *  body, the body assembled into code of its own, which records the arity
+   *  of the formals), i and j are the depth and the index of a variable in
+   *  the environment (see meevax/kernel/frame.hpp), and l is the address of
+   *  the instruction list it replaces, as an index into the same code. The
+   *  other operands that are objects (bindings, syntactic keywords, ...) are
+   *  pooled likewise. STORE_LOCAL takes the same operands as LOAD_LOCAL.
+   *  n is the number of the operands of a procedure call, or #f where the
+   *  operands are a list, assembled as operand_list, and m is the index of
+   *  the inline cache of the call (see code::cache). TAIL_CALL takes the
+   *  same operands as CALL.
+   *  Branches are laid out after the end of the code that selects them, so
+   *  that the code of a procedure runs straight through when no branch is
+   *  taken.
+   *
+   *  Some pairs of instructions that are frequently executed one after the
+   *  other are assembled into a superinstruction that does the work of both
+   *  with one dispatch, and takes the operands of both, followed by C:
+   *
+   *    (LOAD-GLOBAL k CALL n . C)                    CALL_GLOBAL k n m
+   *    (LOAD-GLOBAL k TAIL-CALL n . C)               TAIL_CALL_GLOBAL k n m
+   *    (LOAD-CONSTANT x LOAD-LOCAL (i . j) . C)      LOAD_CONSTANT_LOCAL k i j
+   *    (LOAD-LOCAL (i . j) LOAD-LOCAL (i' . j') . C) LOAD_LOCAL_LOCAL i j i' j'
+   *
+   *  The constant pool is kept as a list in the car of the code object, so
+   *  that the collector traces it as usual, and the addresses of the cells of
+   *  that list are kept alongside to index it in constant time. The words
+   *  themselves hold no references and are not traced.
+   *
+   *  Where the machine dispatches by computed goto, it threads code before
+   *  running it the first time: each opcode is replaced with the address of
+   *  the handler of the instruction, given by a table indexed by opcode, so
+   *  that dispatch is a single indirect jump. opcode decodes either form.
+   *  Code may be shared by machines on several threads (the code of a
+   *  static, for example), so it is threaded exactly once, under a once
+   *  flag, and the table is published only after every opcode is replaced.
+   *  A machine in trace mode or profile mode reads code without threading
+   *  it, so it must not share code with a machine that is running it for
+   *  the first time on another thread.
+   *
+   * ------------------------------------------------------------------------ */
+  constexpr auto operand_list = std::numeric_limits<std::uintptr_t>::max();
+
+  struct procedure;
+
+  struct code
+    : public virtual pair
+  {
+    /* ---- Inline Cache -------------------------------------------------------
+     *
+     *  Each call instruction has a cache of its own, of the object it called
+     *  last and what that object was found to be: a closure, with the code of
+     *  its body, or a primitive procedure. A call of the same object again
+     *  takes it from the cache instead of testing the type of the callee and
+     *  converting it. The number of the operands is checked against the arity
+     *  of a closure on every call, hit or miss, as the frame is made.
+     *
+     *  A cache is keyed by the identity of the callee, so it is never stale:
+     *  when a global variable is redefined, the next call through it misses
+     *  and refills the cache. The cache does not keep the last object it
+     *  called (and its environment) alive. Instead, the address of the callee
+     *  is compared together with the free epoch of the collector it was
+     *  cached in, so once the callee may have been freed the next call misses,
+     *  even if another object has been allocated at the same address. This
+     *  costs the cache nothing during a collection.
+     *
+     * ---------------------------------------------------------------------- */
+    struct cache
+    {
+      memory::pointer<pair const> callee = nullptr;
+
+      std::size_t epoch = 0; // the free epoch of the collector when the callee was cached
+
+      memory::pointer<code> body = nullptr; // if the callee is a closure
+
+      memory::pointer<procedure const> primitive = nullptr; // if the callee is a primitive procedure
+    };
+
+    using pair::pair;
+
+    std::vector<std::uintptr_t> instructions;
+
+    std::vector<memory::pointer<let>> constants;
+
+    std::vector<cache> caches;
+
+    std::atomic<memory::pointer<void * const>> handlers = nullptr; // that the code is threaded with, if any
+
+    std::once_flag threaded;
+
+    std::size_t arity = 0; // the number of the required parameters
+
+    bool variadic = false; // whether there is a rest parameter
+
+    auto operator [](std::size_t const index) const noexcept
+    {
+      return instructions[index];
+    }
+
+    auto opcode(std::size_t const index) const noexcept -> mnemonic
+    {
+      if (auto const table = handlers.load(std::memory_order_acquire); table)
+      {
+        auto const handler = reinterpret_cast<void *>(instructions[index]);
+        return static_cast<mnemonic>(std::find(table, table + BOOST_PP_SEQ_SIZE(MNEMONICS), handler) - table);
+      }
+      else
+      {
+        return static_cast<mnemonic>(instructions[index]);
+      }
+    }
+
+    void thread(memory::pointer<void * const> const table)
+    {
+      if (not handlers.load(std::memory_order_acquire))
+      {
+        std::call_once(threaded, [&]()
+        {
+          for (std::size_t index = 0; index < std::size(instructions); )
+          {
+            auto const code = static_cast<mnemonic>(instructions[index]);
+            instructions[index] = reinterpret_cast<std::uintptr_t>(table[static_cast<std::size_t>(code)]);
+            index += width(code);
+          }
+
+          handlers.store(table, std::memory_order_release);
+        });
+      }
+    }
+
+    auto constant(std::size_t const index) const noexcept -> let const&
+    {
+      return *constants[index];
+    }
+
+    auto push_constant(let const& x) -> std::size_t
+    {
+      car(*this) = cons(x, car(*this));
+      constants.push_back(&caar(*this));
+      return std::size(constants) - 1;
+    }
+
+    auto push_cache() -> std::size_t
+    {
+      caches.emplace_back();
+      return std::size(caches) - 1;
+    }
+  };
+
+  auto operator <<(std::ostream &, code const&) -> std::ostream &;
+
+  auto assemble(let const&, let const& = unit) -> let;
+
+  auto disassemble(std::ostream &, let const&, std::size_t = 1) -> std::ostream &;
+} // namespace kernel
+} // namespace meevax
+
+#endif // INCLUDED_MEEVAX_KERNEL_CODE_HPP
@@ -4,8 +4,11 @@
 #include <regex>
 
 #include <meevax/kernel/ghost.hpp>
+#include <meevax/kernel/heap.hpp>
+#include <meevax/kernel/number.hpp>
 #include <meevax/kernel/path.hpp>
 #include <meevax/kernel/procedure.hpp>
+#include <meevax/kernel/profile.hpp>
 #include <meevax/kernel/stack.hpp>
 #include <meevax/kernel/string.hpp>
 #include <meevax/kernel/version.hpp>
@@ -34,6 +37,7 @@ inline namespace kernel
     let batch_mode       = f;
     let debug_mode       = f;
     let interactive_mode = f;
+    let profile_mode     = f;
     let trace_mode       = f;
     let verbose_mode     = f;
 
@@ -49,6 +53,7 @@ inline namespace kernel
     BOILERPLATE(batch_mode);
     BOILERPLATE(debug_mode);
     BOILERPLATE(interactive_mode);
+    BOILERPLATE(profile_mode);
     BOILERPLATE(trace_mode);
     BOILERPLATE(verbose_mode);
 
@@ -100,9 +105,17 @@ inline namespace kernel
       write_line("  ", BOLD("-e"), ", ", BOLD("--evaluate"), "=", UNDERLINE("expression"), "  Evaluate an ", UNDERLINE("expression"), " at configuration time.");
       write_line("  ", BOLD("  "), "  ", BOLD("--echo"), "=", UNDERLINE("expression"), "      Write ", UNDERLINE("expression"), ".");
       write_line("  ", BOLD("-f"), ", ", BOLD("--feature"), "=", UNDERLINE("identifier"), "   (unimplemented)");
+      write_line("  ", BOLD("  "), "  ", BOLD("--gc-dump"), "=", UNDERLINE("file"), "         Dump the heap to ", UNDERLINE("file"), " on SIGUSR1.");
+      write_line("  ", BOLD("  "), "  ", BOLD("--gc-growth"), "=", UNDERLINE("real"), "       Collect garbage when the heap has grown to ", UNDERLINE("real"), " times its live data (default 2).");
+      write_line("  ", BOLD("  "), "  ", BOLD("--gc-limit"), "=", UNDERLINE("integer"), "     Raise an error when the heap would exceed ", UNDERLINE("integer"), " bytes.");
+      write_line("  ", BOLD("  "), "  ", BOLD("--gc-max"), "=", UNDERLINE("integer"), "       Collect garbage at least once per ", UNDERLINE("integer"), " bytes allocated (default 1 GiB).");
+      write_line("  ", BOLD("  "), "  ", BOLD("--gc-min"), "=", UNDERLINE("integer"), "       Collect garbage at most once per ", UNDERLINE("integer"), " bytes allocated (default 16 MiB).");
+      write_line("  ", BOLD("  "), "  ", BOLD("--gc-pause"), "=", UNDERLINE("integer"), "     Collect garbage incrementally in pauses of at most ", UNDERLINE("integer"), " microseconds.");
+      write_line("  ", BOLD("  "), "  ", BOLD("--gc-stats"), "             Display statistics of the garbage collector at exit.");
       write_line("  ", BOLD("-h"), ", ", BOLD("--help"), "                 Display this help text and exit.");
       write_line("  ", BOLD("-i"), ", ", BOLD("--interactive"), "          Interactive mode: Take over control of root syntactic-continuation.");
       write_line("  ", BOLD("-l"), ", ", BOLD("--load"), "=", UNDERLINE("file"), "            Load ", UNDERLINE("file"), " before main session.");
+      write_line("  ", BOLD("  "), "  ", BOLD("--profile"), "              Profile mode: Display the most frequent sequences of instructions at exit.");
       write_line("  ", BOLD("-r"), ", ", BOLD("--revised"), "=", UNDERLINE("integer"), "      (unimplemented)");
       write_line("  ", BOLD("-t"), ", ", BOLD("--trace"), "                Trace mode: Display stacks of virtual machine for each instruction.");
       write_line("  ", BOLD("-v"), ", ", BOLD("--version"), "              Display version information and exit.");
@@ -124,6 +137,45 @@ inline namespace kernel
       #undef UNDERLINE
     }
 
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Registered with std::atexit by --gc-stats, so the summary is written
+     *  however the program ends. Written to std::cerr in the C++ way, as the
+     *  ports of the root syntactic-continuation may already be gone.
+     *
+     * ---------------------------------------------------------------------- */
+    static void display_gc_statistics()
+    {
+      auto const& stats = gc.stats();
+
+      auto const header = meevax::header("gc-statistics");
+
+      auto microseconds = [](auto const& duration)
+      {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+      };
+
+      std::cerr << header << "allocated " << stats.allocated_bytes << " bytes in " << stats.allocated_objects << " objects\n"
+                << header << "collected " << stats.minor_collections << " minor, " << stats.major_collections << " major\n"
+                << header << "marked for " << microseconds(stats.mark_time) << " us, swept for " << microseconds(stats.sweep_time) << " us\n"
+                << header << "paused for " << microseconds(stats.total_pause) << " us, at most " << microseconds(stats.max_pause) << " us\n";
+
+      for (std::size_t k = 0; k < std::size(stats.pause_histogram); ++k)
+      {
+        if (auto const count = stats.pause_histogram[k]; count)
+        {
+          std::cerr << header << "  pauses < " << (std::size_t(1) << k) << " us: " << count << "\n";
+        }
+      }
+
+      std::cerr << header << "live " << stats.live_bytes << " bytes in " << stats.live_objects << " objects after the last collection\n";
+
+      for (auto const& [name, count] : census())
+      {
+        std::cerr << header << "  " << count << " " << name << "\n";
+      }
+    }
+
     let const& append_path(let const& x)
     {
       if (x.is<symbol>())
@@ -198,6 +250,12 @@ inline namespace kernel
         return debug_mode = t;
       }),
 
+      std::make_pair("gc-stats", [](auto&&...)
+      {
+        [[maybe_unused]] static auto const registered = std::atexit(display_gc_statistics);
+        return unspecified;
+      }),
+
       std::make_pair("help", [this](auto&&...)
       {
         display_help();
@@ -209,6 +267,12 @@ inline namespace kernel
         return interactive_mode = t;
       }),
 
+      std::make_pair("profile", [this](auto&&...)
+      {
+        [[maybe_unused]] static auto const registered = std::atexit(profile::report);
+        return profile_mode = t;
+      }),
+
       // TODO --srfi=0,1,2
       // TODO --reviced=4,5,7
 
@@ -243,6 +307,42 @@ inline namespace kernel
         return unspecified;
       }),
 
+      std::make_pair("gc-dump", [](let const& x)
+      {
+        dump_heap_on_signal(x.is<symbol>() ? x.as<std::string>() : static_cast<std::string>(x.as<string>()));
+        return unspecified;
+      }),
+
+      std::make_pair("gc-growth", [](let const& x)
+      {
+        gc.reset_heap_growth(inexact(x).as<double_float>());
+        return unspecified;
+      }),
+
+      std::make_pair("gc-limit", [](let const& x)
+      {
+        gc.reset_heap_limit(x.as<exact_integer>().to<std::size_t>());
+        return unspecified;
+      }),
+
+      std::make_pair("gc-max", [](let const& x)
+      {
+        gc.reset_max_threshold(x.as<exact_integer>().to<std::size_t>());
+        return unspecified;
+      }),
+
+      std::make_pair("gc-min", [](let const& x)
+      {
+        gc.reset_min_threshold(x.as<exact_integer>().to<std::size_t>());
+        return unspecified;
+      }),
+
+      std::make_pair("gc-pause", [](let const& x)
+      {
+        gc.reset_pause_budget(std::chrono::microseconds(x.as<exact_integer>().to<std::size_t>()));
+        return unspecified;
+      }),
+
       std::make_pair("load", [this](auto&&... xs)
       {
         return append_path(std::forward<decltype(xs)>(xs)...);
@@ -338,7 +438,7 @@ inline namespace kernel
 
       paths = reverse(paths);
 
-      if (auto const rc = path(::getenv("HOME")) / ".meevaxrc"; in_interactive_mode() and std::experimental::filesystem::exists(rc))
+      if (auto const rc = path(::getenv("HOME")) / ".meevaxrc"; in_interactive_mode() and exists(rc))
       {
         paths = cons(make<path>(rc), paths);
       }
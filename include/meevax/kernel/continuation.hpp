@@ -7,15 +7,32 @@ namespace meevax
 {
 inline namespace kernel
 {
+  /* ---- Continuation -------------------------------------------------------
+   *
+   *  (s e c pc fp . d), where c is the code to resume and pc is the index of
+   *  the instruction in it, and s and d are the stacks of the machine copied
+   *  into lists (see meevax/kernel/stack.hpp). pc and fp are fixnums.
+   *
+   * ------------------------------------------------------------------------ */
   struct continuation
     : public virtual pair
   {
     using pair::pair;
 
-    auto s() const { return   car(*this); }
-    auto e() const { return  cadr(*this); }
-    auto c() const { return caddr(*this); }
-    auto d() const { return cdddr(*this); }
+    auto s() const { return         car(*this); }
+    auto e() const { return        cadr(*this); }
+    auto c() const { return       caddr(*this); }
+    auto d() const { return cdr(cddddr(*this)); }
+
+    auto pc() const -> std::size_t
+    {
+      return unbox(cadddr(*this).get()); // always a fixnum
+    }
+
+    auto fp() const -> std::size_t
+    {
+      return unbox(car(cddddr(*this)).get()); // always a fixnum
+    }
   };
 
   auto operator <<(std::ostream &, continuation const&) -> std::ostream &;
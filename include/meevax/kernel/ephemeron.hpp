@@ -0,0 +1,32 @@
+#ifndef INCLUDED_MEEVAX_KERNEL_EPHEMERON_HPP
+#define INCLUDED_MEEVAX_KERNEL_EPHEMERON_HPP
+
+#include <meevax/kernel/boolean.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  /* ---- SRFI 124 Ephemerons --------------------------------------------------
+   *
+   *  A Scheme ephemeron is a collector ephemeron whose key and datum are
+   *  objects. Once broken, both its key and its datum read as #f.
+   *
+   * ------------------------------------------------------------------------ */
+  struct ephemeron
+    : public collector::ephemeron
+  {
+    explicit ephemeron(let const& key, let const& datum)
+      : collector::ephemeron { key.get(), datum.get() }
+    {}
+
+    auto key() const -> let;
+
+    auto datum() const -> let;
+  };
+
+  auto operator <<(std::ostream &, ephemeron const&) -> std::ostream &;
+} // namespace kernel
+} // namespace meevax
+
+#endif // INCLUDED_MEEVAX_KERNEL_EPHEMERON_HPP
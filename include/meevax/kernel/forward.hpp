@@ -3,6 +3,7 @@
 
 #include <meevax/functional/operator.hpp>
 #include <meevax/memory/cell.hpp>
+#include <meevax/memory/tagged_pointer.hpp>
 #include <meevax/posix/vt10x.hpp>
 #include <meevax/string/append.hpp>
 #include <meevax/utility/debug.hpp>
@@ -18,8 +19,16 @@ inline namespace kernel
   template <template <typename...> typename Pointer, typename T>
   class heterogeneous;
 
+  struct boolean;
+
+  struct character;
+
+  struct exact_integer;
+
   struct pair;
 
+  struct unspecified_t;
+
   using let = heterogeneous<cell, pair>;
 
   using null = std::nullptr_t;
@@ -27,6 +36,10 @@ inline namespace kernel
   using  input_port = std::istream;
   using output_port = std::ostream;
 
+  auto type_of_immediate(let const&) -> std::type_info const&;
+
+  auto write_immediate(output_port &, let const&) -> output_port &;
+
   template <typename... Ts>
   using define = typename identity<Ts...>::type;
 
@@ -36,6 +49,21 @@ inline namespace kernel
     return std::runtime_error(string_append(std::forward<decltype(xs)>(xs)...));
   }
 } // namespace kernel
+
+inline namespace memory
+{
+  /* ---- Immediate Types ------------------------------------------------------
+   *
+   *  Kernel types stored in the pointer word instead of the heap. They are
+   *  specialized here, before heterogeneous is defined, because its type
+   *  dispatch switches on these tags.
+   *
+   * ------------------------------------------------------------------------ */
+  template <> struct tag<kernel::exact_integer> : public std::integral_constant<word, 0b001> {};
+  template <> struct tag<kernel::character>     : public std::integral_constant<word, 0b010> {};
+  template <> struct tag<kernel::boolean>       : public std::integral_constant<word, 0b011> {};
+  template <> struct tag<kernel::unspecified_t> : public std::integral_constant<word, 0b100> {};
+} // namespace memory
 } // namespace meevax
 
 #endif // INCLUDED_MEEVAX_KERNEL_PREFACE_HPP
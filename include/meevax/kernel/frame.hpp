@@ -0,0 +1,156 @@
+#ifndef INCLUDED_MEEVAX_KERNEL_FRAME_HPP
+#define INCLUDED_MEEVAX_KERNEL_FRAME_HPP
+
+#include <memory> // std::destroy_n
+
+#include <meevax/kernel/error.hpp>
+#include <meevax/kernel/stack.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  /* ---- Frame ----------------------------------------------------------------
+   *
+   *  An environment frame holds the values of the parameters of a procedure
+   *  call, in cells that follow the frame in the same region of the heap,
+   *  and refers to the environment that encloses it. An environment is the
+   *  innermost frame, or () outside of any procedure.
+   *
+   *  The compiler resolves a local variable to its depth (the number of
+   *  frames to go out) and its index in the frame, so that referring to it
+   *  takes no search. A procedure with a rest parameter keeps the rest of
+   *  the operands as a list in the last cell of its frame.
+   *
+   *  A frame is made either from a list of operands (for a macro, say) or
+   *  from the operands of a procedure call where the machine left them on
+   *  its stack, in which case only the rest of the operands, if any, are
+   *  made into a list.
+   *
+   * ------------------------------------------------------------------------ */
+  struct frame
+  {
+    let const parent;
+
+    pointer<frame> const up; // the parent, or nullptr if the parent is ()
+
+    pointer<let> const data;
+
+    std::size_t const size;
+
+    explicit frame(pointer<let> const data, std::size_t const arity, bool const variadic, let const& operands, let const& parent)
+      : parent { parent }
+      , up { parent.is<null>() ? nullptr : &of(parent) }
+      , data { data }
+      , size { arity + variadic }
+    {
+      let xs = operands;
+
+      for (std::size_t index = 0; index < arity; ++index, xs = cdr(xs))
+      {
+        new (data + index) let(car(xs));
+      }
+
+      if (variadic)
+      {
+        new (data + arity) let(xs);
+      }
+    }
+
+    explicit frame(pointer<let> const data, std::size_t const arity, bool const variadic, stack const& s, let const& rest, let const& parent)
+      : parent { parent }
+      , up { parent.is<null>() ? nullptr : &of(parent) }
+      , data { data }
+      , size { arity + variadic }
+    {
+      for (std::size_t index = 0; index < arity; ++index)
+      {
+        new (data + index) let(s[index + 1]);
+      }
+
+      if (variadic)
+      {
+        new (data + arity) let(rest);
+      }
+    }
+
+    ~frame()
+    {
+      std::destroy_n(data, size);
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  An environment other than () is always a frame made by make_frame, so
+     *  the machine takes the frame of a reference to a local variable without
+     *  the checked conversion of as<frame>.
+     *
+     * ---------------------------------------------------------------------- */
+    static auto of(let const& environment) -> frame &
+    {
+      return environment.unchecked_as<frame>();
+    }
+
+    auto operator [](std::size_t const index) const noexcept -> let &
+    {
+      return data[index];
+    }
+
+    auto outer(std::size_t depth) const noexcept -> frame const&
+    {
+      auto f = this;
+
+      while (depth--)
+      {
+        f = f->up;
+      }
+
+      return *f;
+    }
+  };
+
+  auto operator <<(std::ostream &, frame const&) -> std::ostream &;
+
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  Binds the operands to the parameters of a procedure that takes arity
+   *  operands and, if variadic, a list of the rest. Operands in excess of
+   *  the parameters of a procedure that is not variadic are ignored, as they
+   *  always have been (the basis library relies on it).
+   *
+   * ------------------------------------------------------------------------ */
+  inline auto make_frame(std::size_t const arity, bool const variadic, let const& operands, let const& parent) -> let
+  {
+    let xs = operands;
+
+    for (std::size_t index = 0; index < arity; ++index, xs = cdr(xs))
+    {
+      if (not xs.is<pair>())
+      {
+        throw error(make<string>("too few arguments"), operands);
+      }
+    }
+
+    return let::allocate_with_cells<frame>(arity + variadic, arity, variadic, operands, parent);
+  }
+
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  Binds the n operands under the top of the stack s (see CALL) likewise.
+   *  The list of the rest is made before the frame is allocated, as the
+   *  cells of a frame under construction are not traced yet.
+   *
+   * ------------------------------------------------------------------------ */
+  inline auto make_frame(std::size_t const arity, bool const variadic, stack const& s, std::size_t const n, let const& parent) -> let
+  {
+    if (n < arity)
+    {
+      throw error(make<string>("too few arguments"), s.list(1, n + 1));
+    }
+
+    return let::allocate_with_cells<frame>(arity + variadic, arity, variadic, s, variadic ? s.list(arity + 1, n + 1) : unit, parent);
+  }
+} // namespace kernel
+} // namespace meevax
+
+#endif // INCLUDED_MEEVAX_KERNEL_FRAME_HPP
@@ -0,0 +1,44 @@
+#ifndef INCLUDED_MEEVAX_KERNEL_HEAP_HPP
+#define INCLUDED_MEEVAX_KERNEL_HEAP_HPP
+
+#include <map>
+
+#include <meevax/kernel/pair.hpp>
+#include <meevax/memory/snapshot.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  /* ---- Census ---------------------------------------------------------------
+   *
+   *  Counts the objects in the heap for each type, keyed by the demangled name
+   *  of their type(). Every object in the heap derives from pair, which is
+   *  the type the collector finalizes them as.
+   *
+   * ------------------------------------------------------------------------ */
+  auto census() -> std::map<std::string, std::size_t>;
+
+  /* ---- Heap Snapshot --------------------------------------------------------
+   *
+   *  Takes a snapshot of the heap with the objects named by the demangled
+   *  name of their type(), and writes it to a file in the format described in
+   *  meevax/memory/snapshot.hpp. The heap is collected first, so that only
+   *  live objects are written.
+   *
+   *  dump_heap_on_signal arranges for the heap to be dumped to the given file
+   *  whenever the process receives SIGUSR1. The handler only posts a request,
+   *  and the machine writes the snapshot at the next procedure call.
+   *
+   * ------------------------------------------------------------------------ */
+  auto take_heap_snapshot() -> snapshot;
+
+  void dump_heap(std::string const&);
+
+  void dump_heap_on_signal(std::string const&);
+
+  auto heap_dump_path() -> std::string const&;
+} // namespace kernel
+} // namespace meevax
+
+#endif // INCLUDED_MEEVAX_KERNEL_HEAP_HPP
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <meevax/functional/compose.hpp>
 #include <meevax/memory/cell.hpp>
+#include <meevax/memory/tagged_pointer.hpp>
 #include <meevax/type_traits/is_equality_comparable.hpp>
 #include <meevax/utility/delay.hpp>
 #include <meevax/utility/module.hpp>
@@ -85,27 +86,224 @@ inline namespace kernel
     template <typename Bound, typename... Ts, REQUIRES(std::is_compound<Bound>)>
     static auto allocate(Ts&&... xs)
     {
-      if constexpr (std::is_same<Bound, Top>::value)
+      if constexpr (is_immediate<Bound>::value)
+      {
+        return immediate<Bound>(std::forward<decltype(xs)>(xs)...);
+      }
+      else if constexpr (std::is_same<Bound, Top>::value)
       {
         return static_cast<heterogeneous>(new (gc) Top(std::forward<decltype(xs)>(xs)...));
       }
       else
       {
-        return static_cast<heterogeneous>(new (gc) binder<Bound>(std::forward<decltype(xs)>(xs)...));
+        return bind<Bound>(std::forward<decltype(xs)>(xs)...);
+      }
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Allocates an object followed by n cells in the same region, for an
+     *  object that holds a number of references known only at run time (see
+     *  meevax/kernel/frame.hpp). The cells are inside the heap, so they are
+     *  traced with the object instead of being roots. Bound is constructed
+     *  with the address of the first cell, and constructs and destroys the
+     *  cells itself. Its constructor must not throw.
+     *
+     *  Such an object is never finalized lazily, although Bound is not
+     *  trivially destructible: its destructor only destroys cells inside the
+     *  heap, which own nothing outside it, so the sweep runs it in place and
+     *  an arena frees the object without running it, as for a pair.
+     *
+     * ---------------------------------------------------------------------- */
+    template <typename Bound, typename... Ts>
+    static auto allocate_with_cells(std::size_t const n, Ts&&... xs) -> heterogeneous
+    {
+      static_assert(not std::is_base_of<Top, Bound>::value);
+
+      auto const data = gc.allocate(sizeof(binder<Bound>) + sizeof(heterogeneous) * n);
+
+      auto const cells = reinterpret_cast<pointer<heterogeneous>>(static_cast<pointer<binder<Bound>>>(data) + 1);
+
+      return static_cast<heterogeneous>(new (data) binder<Bound>(cells, std::forward<decltype(xs)>(xs)...));
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Returns the Bound of an object that the caller knows to be allocated by
+     *  allocate_with_cells<Bound>, without checking its type. The binder is
+     *  the most-derived object, and Bound a non-virtual base of it, so only
+     *  the offset of the most-derived object is read from the object; the
+     *  offset of Bound in it is fixed at compile time.
+     *
+     * ---------------------------------------------------------------------- */
+    template <typename Bound>
+    auto unchecked_as() const noexcept -> Bound &
+    {
+      return *static_cast<pointer<binder<Bound>>>(dynamic_cast<pointer<void>>(Pointer<Top>::get()));
+    }
+
+  private:
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Objects that are not pairs and are not trivially destructible own
+     *  memory outside the heap (strings, vectors, big integers, ports, ...),
+     *  so their destructors are left to the finalization queue of the
+     *  collector rather than run within the pause that finds them dead.
+     *
+     *  An arena frees objects derived from pairs without destroying them,
+     *  which is only right for those that hold nothing but the cells of the
+     *  pair. Such an object derives from Top virtually (as binder requires),
+     *  so it adds no data members to the pair exactly when it is no larger
+     *  than cells_only. Any other object derived from a pair, such as code or
+     *  a syntactic continuation, is finalized lazily as well. Objects with
+     *  cells of their own, such as frames, are not made by bind (see
+     *  allocate_with_cells).
+     *
+     * ---------------------------------------------------------------------- */
+    struct cells_only : public virtual Top
+    {};
+
+    template <typename Bound>
+    static constexpr auto finalized_lazily = std::is_base_of<Top, Bound>::value ? sizeof(cells_only) < sizeof(Bound)
+                                                                                : not std::is_trivially_destructible<Bound>::value;
+
+    template <typename Bound, typename... Ts>
+    static auto bind(Ts&&... xs) -> heterogeneous
+    {
+      auto const p = new (gc) binder<Bound>(std::forward<decltype(xs)>(xs)...);
+
+      if constexpr (finalized_lazily<Bound>)
+      {
+        collector::finalize_lazily(p);
+      }
+
+      return static_cast<heterogeneous>(p);
+    }
+
+    /* ---- Immediate Values ---------------------------------------------------
+     *
+     *  Booleans, characters and the unspecified value are always stored in
+     *  the pointer word, and so is an exact integer while it fits in the
+     *  payload (32 bits, or 29 with compressed references). Making them does
+     *  not allocate, and the collector never follows them. A larger exact
+     *  integer is boxed as usual, so every exact integer has exactly one
+     *  representation and eqv? on immediate values is a comparison of words.
+     *
+     * ---------------------------------------------------------------------- */
+    template <typename T>
+    static constexpr auto fits(T const& x)
+    {
+      if constexpr (std::is_signed<T>::value)
+      {
+        return payload_min <= x and x <= payload_max;
+      }
+      else
+      {
+        return x <= static_cast<typename std::make_unsigned<std::int32_t>::type>(payload_max);
+      }
+    }
+
+    template <typename Bound, typename... Ts>
+    static auto immediate(Ts&&... xs) -> heterogeneous
+    {
+      if constexpr (std::is_same<Bound, exact_integer>::value)
+      {
+        if constexpr (sizeof...(Ts) == 1 and std::conjunction<std::is_integral<typename std::decay<Ts>::type>...>::value)
+        {
+          if (fits(xs...))
+          {
+            return static_cast<heterogeneous>(reinterpret_cast<pointer<Top>>(box<Bound>(xs...)));
+          }
+        }
+
+        if (Bound datum { std::forward<decltype(xs)>(xs)... };
+            payload_min <= datum.value and datum.value <= payload_max)
+        {
+          return static_cast<heterogeneous>(reinterpret_cast<pointer<Top>>(box<Bound>(datum.template to<std::int32_t>())));
+        }
+        else
+        {
+          return bind<Bound>(std::move(datum));
+        }
+      }
+      else if constexpr (std::is_empty<Bound>::value)
+      {
+        return static_cast<heterogeneous>(reinterpret_cast<pointer<Top>>(box<Bound>(0)));
+      }
+      else
+      {
+        Bound const datum { std::forward<decltype(xs)>(xs)... };
+        return static_cast<heterogeneous>(reinterpret_cast<pointer<Top>>(box<Bound>(datum.value)));
+      }
+    }
+
+  public:
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  An immediate value has no storage, so there is no object to load and
+     *  no car or cdr to read or to store into: loading it is an error, like
+     *  taking the car of any other object that is not a pair.
+     *
+     * ---------------------------------------------------------------------- */
+    auto load() const -> Top &
+    {
+      if (tag_of(Pointer<Top>::get()))
+      {
+        throw make_error("not a pair: ", *this);
+      }
+      else
+      {
+        return Pointer<Top>::load();
+      }
+    }
+
+    template <typename F>
+    auto visit(F&& f) const -> decltype(auto)
+    {
+      switch (tag_of(Pointer<Top>::get()))
+      {
+      case tag<boolean>::value:
+        return f(as<boolean>());
+
+      case tag<character>::value:
+        return f(as<character>());
+
+      case tag<exact_integer>::value:
+        return f(as<exact_integer>());
+
+      case tag<unspecified_t>::value:
+        return f(as<unspecified_t>());
+
+      default:
+        throw make_error("unknown immediate value ", reinterpret_cast<word>(Pointer<Top>::get()));
       }
     }
 
   public: /* ---- TYPE PREDICATES ------------------------------------------- */
 
-    auto type() const -> decltype(auto)
+    auto type() const -> std::type_info const&
     {
-      return *this ? Pointer<Top>::load().type() : typeid(null);
+      if (tag_of(Pointer<Top>::get()))
+      {
+        return type_of_immediate(*this);
+      }
+      else
+      {
+        return *this ? Pointer<Top>::load().type() : typeid(null);
+      }
     }
 
     template <typename U>
     auto is() const
     {
-      return type() == typeid(typename std::decay<U>::type);
+      if (auto const t = tag_of(Pointer<Top>::get()); t)
+      {
+        return t == tag<typename std::decay<U>::type>::value;
+      }
+      else
+      {
+        return type() == typeid(typename std::decay<U>::type);
+      }
     }
 
     template <typename U,
@@ -120,62 +318,163 @@ inline namespace kernel
     template <typename U>
     auto is_polymorphically() const
     {
-      return dynamic_cast<pointer<const U>>(Pointer<Top>::get()) != nullptr;
+      return not tag_of(Pointer<Top>::get()) and dynamic_cast<pointer<const U>>(Pointer<Top>::get()) != nullptr;
     }
 
   public: /* ---- ACCESSORS ------------------------------------------------- */
 
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  An immediate value has no address to refer to, so for the types that
+     *  have an immediate representation, as returns a copy.
+     *
+     * ---------------------------------------------------------------------- */
     template <typename U>
-    auto as() const -> typename std::add_lvalue_reference<U>::type
+    auto as() const -> typename std::conditional<is_immediate<typename std::decay<U>::type>::value,
+                                                 typename std::decay<U>::type,
+                                                 typename std::add_lvalue_reference<U>::type>::type
     {
-      if (auto * const address = dynamic_cast<U *>(Pointer<Top>::get()); address)
+      using T = typename std::decay<U>::type;
+
+      if constexpr (is_immediate<T>::value)
+      {
+        if (tag_of(Pointer<Top>::get()) == tag<T>::value)
+        {
+          if constexpr (std::is_empty<T>::value)
+          {
+            return T();
+          }
+          else
+          {
+            return T(unbox(Pointer<Top>::get()));
+          }
+        }
+      }
+
+      if (auto * const address = tag_of(Pointer<Top>::get()) ? nullptr : dynamic_cast<U *>(Pointer<Top>::get()); address)
       {
         return *address;
       }
       else
       {
-        throw make_error(
-          "no viable conversion from ", demangle(Pointer<Top>::load().type()), " to ", demangle(typeid(U)));
+        throw make_error("no viable conversion from ", demangle(type()), " to ", demangle(typeid(U)));
       }
     }
 
     bool eqv(heterogeneous const& rhs) const
     {
-      return type() == rhs.type() and Pointer<Top>::load().eqv(rhs);
+      if (tag_of(Pointer<Top>::get()) or tag_of(rhs.get()))
+      {
+        return Pointer<Top>::get() == rhs.get();
+      }
+      else
+      {
+        return type() == rhs.type() and Pointer<Top>::load().eqv(rhs);
+      }
     }
   };
 
   template <template <typename...> typename Pointer, typename Top>
   auto operator <<(std::ostream & port, heterogeneous<Pointer, Top> const& datum) -> std::ostream &
   {
-    return (datum.template is<null>() ? port << magenta << "()" : datum.load().write_to(port)) << reset;
+    if (tag_of(datum.get()))
+    {
+      return write_immediate(port, datum) << reset;
+    }
+    else
+    {
+      return (datum.template is<null>() ? port << magenta << "()" : datum.load().write_to(port)) << reset;
+    }
+  }
+
+  /* ---- Binary Operations ----------------------------------------------------
+   *
+   *  Operations on two fixnums are done on their payloads in 64 bits, which
+   *  cannot overflow, and the result is boxed again if it fits. Otherwise the
+   *  left operand dispatches on its dynamic type: through its vtable if it is
+   *  in the heap, or by unboxing it if it is a fixnum. No other immediate
+   *  type supports arithmetic or ordering.
+   *
+   * ------------------------------------------------------------------------ */
+  template <typename F, template <typename...> typename Pointer, typename Top>
+  auto dispatch(heterogeneous<Pointer, Top> const& a,
+                heterogeneous<Pointer, Top> const& b)
+  {
+    using result_type = decltype(std::declval<F>()(a.load(), b));
+
+    if (tag_of(a.get()) == tag<exact_integer>::value and
+        tag_of(b.get()) == tag<exact_integer>::value)
+    {
+      std::int64_t const x = unbox(a.get());
+      std::int64_t const y = unbox(b.get());
+
+      if constexpr (std::is_same<result_type, bool>::value)
+      {
+        return F()(x, y);
+      }
+      else if constexpr (std::is_same<F, std::divides<void>>::value)
+      {
+        if (y != 0 and x % y == 0)
+        {
+          return heterogeneous<Pointer, Top>::template allocate<exact_integer>(x / y);
+        }
+      }
+      else if constexpr (std::is_same<F, std::modulus<void>>::value)
+      {
+        if (y != 0)
+        {
+          return heterogeneous<Pointer, Top>::template allocate<exact_integer>(x % y);
+        }
+      }
+      else
+      {
+        return heterogeneous<Pointer, Top>::template allocate<exact_integer>(F()(x, y));
+      }
+    }
+
+    if (tag_of(a.get()) == tag<exact_integer>::value)
+    {
+      return delay<F>().template yield<result_type>(a.template as<exact_integer>(), b);
+    }
+    else if (tag_of(a.get()))
+    {
+      if constexpr (std::is_same<result_type, bool>::value)
+      {
+        return false; // as binder does for operations its type does not support
+      }
+      else
+      {
+        throw make_error("no viable operation ", demangle(typeid(F)), " with ", a, " and ", b);
+      }
+    }
+    else if (a and b)
+    {
+      return static_cast<result_type>(F()(a.load(), b));
+    }
+    else
+    {
+      throw make_error("no viable operation ", demangle(typeid(F)), " with ", a, " and ", b);
+    }
   }
 
-  #define BOILERPLATE(SYMBOL)                                                  \
+  #define BOILERPLATE(SYMBOL, FUNCTOR)                                         \
   template <template <typename...> typename Pointer, typename Top>             \
   auto operator SYMBOL(heterogeneous<Pointer, Top> const& a,                   \
                        heterogeneous<Pointer, Top> const& b) -> decltype(auto) \
   {                                                                            \
-    if (a and b)                                                               \
-    {                                                                          \
-      return a.load() SYMBOL b;                                                \
-    }                                                                          \
-    else                                                                       \
-    {                                                                          \
-      throw make_error("no viable operation " #SYMBOL " with ", a, " and ", b); \
-    }                                                                          \
+    return dispatch<FUNCTOR>(a, b);                                            \
   } static_assert(true)
 
-  BOILERPLATE(* );
-  BOILERPLATE(+ );
-  BOILERPLATE(- );
-  BOILERPLATE(/ );
-  BOILERPLATE(% );
+  BOILERPLATE(* , std::multiplies   <void>);
+  BOILERPLATE(+ , std::plus         <void>);
+  BOILERPLATE(- , std::minus        <void>);
+  BOILERPLATE(/ , std::divides      <void>);
+  BOILERPLATE(% , std::modulus      <void>);
 
-  BOILERPLATE(< );
-  BOILERPLATE(<=);
-  BOILERPLATE(> );
-  BOILERPLATE(>=);
+  BOILERPLATE(< , std::less         <void>);
+  BOILERPLATE(<=, std::less_equal   <void>);
+  BOILERPLATE(> , std::greater      <void>);
+  BOILERPLATE(>=, std::greater_equal<void>);
 
   #undef BOILERPLATE
 } // namespace kernel
@@ -14,26 +14,36 @@ namespace meevax
 inline namespace kernel
 {
   #define MNEMONICS                                                            \
+    (ADD2)                                                                     \
     (CALL)                                                                     \
+    (CALL_GLOBAL)                                                              \
+    (CAR)                                                                      \
+    (CDR)                                                                      \
     (CONS)                                                                     \
     (DEFINE)                                                                   \
     (DROP)                                                                     \
+    (EQ)                                                                       \
     (FORK)                                                                     \
     (JOIN)                                                                     \
     (LOAD_CLOSURE)                                                             \
     (LOAD_CONSTANT)                                                            \
+    (LOAD_CONSTANT_LOCAL)                                                      \
     (LOAD_CONTINUATION)                                                        \
     (LOAD_GLOBAL)                                                              \
     (LOAD_LOCAL)                                                               \
-    (LOAD_VARIADIC)                                                            \
+    (LOAD_LOCAL_LOCAL)                                                         \
+    (NULLP)                                                                    \
+    (NUMEQ2)                                                                   \
+    (NUMLT2)                                                                   \
     (RETURN)                                                                   \
     (SELECT)                                                                   \
     (STOP)                                                                     \
     (STORE_GLOBAL)                                                             \
     (STORE_LOCAL)                                                              \
-    (STORE_VARIADIC)                                                           \
     (STRIP)                                                                    \
+    (SUB2)                                                                     \
     (TAIL_CALL)                                                                \
+    (TAIL_CALL_GLOBAL)                                                         \
     (TAIL_SELECT)                                                              \
 
   enum class mnemonic : std::uint8_t
@@ -58,9 +68,55 @@ inline namespace kernel
     }
   };
 
-  auto operator <<(std::ostream &, instruction const&) -> std::ostream &;
+  /* ---- Instruction Width ----------------------------------------------------
+   *
+   *  The number of words that an instruction takes in code: the opcode and
+   *  its inline operands (see meevax/kernel/code.hpp).
+   *
+   * ------------------------------------------------------------------------ */
+  constexpr auto width(mnemonic const code) noexcept -> std::size_t
+  {
+    switch (code)
+    {
+    case mnemonic::CONS:
+    case mnemonic::DROP:
+    case mnemonic::JOIN:
+    case mnemonic::RETURN:
+    case mnemonic::STOP:
+      return 1;
+
+    case mnemonic::ADD2:
+    case mnemonic::CALL:
+    case mnemonic::CAR:
+    case mnemonic::CDR:
+    case mnemonic::EQ:
+    case mnemonic::LOAD_LOCAL:
+    case mnemonic::NULLP:
+    case mnemonic::NUMEQ2:
+    case mnemonic::NUMLT2:
+    case mnemonic::SELECT:
+    case mnemonic::STORE_LOCAL:
+    case mnemonic::SUB2:
+    case mnemonic::TAIL_CALL:
+    case mnemonic::TAIL_SELECT:
+      return 3;
+
+    case mnemonic::CALL_GLOBAL:
+    case mnemonic::LOAD_CONSTANT_LOCAL:
+    case mnemonic::TAIL_CALL_GLOBAL:
+      return 4;
 
-  auto disassemble(std::ostream &, let const&, std::size_t = 1) -> std::ostream &;
+    case mnemonic::LOAD_LOCAL_LOCAL:
+      return 5;
+
+    default:
+      return 2;
+    }
+  }
+
+  auto operator <<(std::ostream &, mnemonic const&) -> std::ostream &;
+
+  auto operator <<(std::ostream &, instruction const&) -> std::ostream &;
 } // namespace kernel
 } // namespace meevax
 
@@ -111,7 +111,7 @@ inline namespace kernel
    *    Schemes that provide it, and cons* in the other half.
    *
    * ------------------------------------------------------------------------ */
-  auto cons = [](auto&&... xs) constexpr
+  inline auto cons = [](auto&&... xs) constexpr
   {
     return (std::forward<decltype(xs)>(xs) | ...);
   };
@@ -123,7 +123,7 @@ inline namespace kernel
    *    Returns a newly allocated list of its arguments.
    *
    * ------------------------------------------------------------------------ */
-  auto list = [](auto&& ... xs) constexpr
+  inline auto list = [](auto&& ... xs) constexpr
   {
     return (std::forward<decltype(xs)>(xs) | ... | unit);
   };
@@ -136,7 +136,7 @@ inline namespace kernel
    *    procedures. The name stands for "eXchanged CONS."
    *
    * ------------------------------------------------------------------------ */
-  auto xcons = [](auto&& d, auto&& a) constexpr
+  inline auto xcons = [](auto&& d, auto&& a) constexpr
   {
     return cons(std::forward<decltype(a)>(a), std::forward<decltype(d)>(d));
   };
@@ -150,7 +150,7 @@ inline namespace kernel
    *    arbitrary values.
    *
    * ------------------------------------------------------------------------ */
-  auto make_list = [](std::size_t k, let const& x = unit)
+  inline auto make_list = [](std::size_t k, let const& x = unit)
   {
     let result = list();
 
@@ -171,7 +171,7 @@ inline namespace kernel
    *    in which init-proc is applied to these indices.
    *
    * ------------------------------------------------------------------------ */
-  auto list_tabulate = [](auto n, auto&& initialize)
+  inline auto list_tabulate = [](auto n, auto&& initialize)
   {
     let x = list();
 
@@ -190,7 +190,7 @@ inline namespace kernel
    *    Copies the spine of the argument.
    *
    * ------------------------------------------------------------------------ */
-  auto list_copy = [](auto const& x)
+  inline auto list_copy = [](auto const& x)
   {
     auto copy = [](auto&& rec, let const& x) -> let
     {
@@ -214,7 +214,7 @@ inline namespace kernel
    *    Constructs a circular list of the elements.
    *
    * ------------------------------------------------------------------------ */
-  auto circular_list = [](auto&&... xs)
+  inline auto circular_list = [](auto&&... xs)
   {
     let x = list(std::forward<decltype(xs)>(xs)...);
 
@@ -243,12 +243,12 @@ inline namespace kernel
    *
    * ------------------------------------------------------------------------ */
 
-  auto eq = [](auto const& x, auto const& y) constexpr
+  inline auto eq = [](auto const& x, auto const& y) constexpr
   {
     return x == y;
   };
 
-  auto eqv = [](auto const& x, auto const& y)
+  inline auto eqv = [](auto const& x, auto const& y)
   {
     return x.eqv(y);
   };
@@ -380,7 +380,7 @@ inline namespace kernel
    * ------------------------------------------------------------------------ */
   inline namespace miscellaneous
   {
-    auto length = [](auto const& x) constexpr
+    inline auto length = [](auto const& x) constexpr
     {
       return std::distance(std::cbegin(x), std::cend(x));
     };
@@ -481,7 +481,7 @@ inline namespace kernel
    * ======================================================================== */
   inline namespace searching
   {
-    auto find = [](let const& x, auto&& predicate) constexpr -> let const&
+    inline auto find = [](let const& x, auto&& predicate) constexpr -> let const&
     {
       if (auto const& iter = std::find_if(std::cbegin(x), std::cend(x), std::forward<decltype(predicate)>(predicate)); iter)
       {
@@ -520,7 +520,7 @@ inline namespace kernel
    * ======================================================================== */
   inline namespace association_list
   {
-    auto assoc = [](let const& key, let const& alist, auto&& compare = equivalence_comparator<2>()) constexpr
+    inline auto assoc = [](let const& key, let const& alist, auto&& compare = equivalence_comparator<2>()) constexpr
     {
       return find(alist, [&](auto&& each)
              {
@@ -528,17 +528,17 @@ inline namespace kernel
              });
     };
 
-    auto assv = [](auto&&... xs) constexpr
+    inline auto assv = [](auto&&... xs) constexpr
     {
       return assoc(std::forward<decltype(xs)>(xs)..., equivalence_comparator<1>());
     };
 
-    auto assq = [](auto&&... xs) constexpr
+    inline auto assq = [](auto&&... xs) constexpr
     {
       return assoc(std::forward<decltype(xs)>(xs)..., equivalence_comparator<0>());
     };
 
-    auto alist_cons = [](auto&& key, auto&& datum, auto&& alist) constexpr
+    inline auto alist_cons = [](auto&& key, auto&& datum, auto&& alist) constexpr
     {
       return cons(cons(key, datum), alist);
     };
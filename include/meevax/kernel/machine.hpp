@@ -1,12 +1,21 @@
 #ifndef INCLUDED_MEEVAX_KERNEL_MACHINE_HPP
 #define INCLUDED_MEEVAX_KERNEL_MACHINE_HPP
 
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 #include <meevax/kernel/closure.hpp>
+#include <meevax/kernel/code.hpp>
 #include <meevax/kernel/continuation.hpp>
 #include <meevax/kernel/de_brujin_index.hpp>
+#include <meevax/kernel/frame.hpp>
 #include <meevax/kernel/ghost.hpp>
+#include <meevax/kernel/heap.hpp>
 #include <meevax/kernel/instruction.hpp>
 #include <meevax/kernel/procedure.hpp>
+#include <meevax/kernel/profile.hpp>
 #include <meevax/kernel/stack.hpp>
 #include <meevax/kernel/syntactic_keyword.hpp>
 #include <meevax/kernel/syntax.hpp>
@@ -39,10 +48,16 @@ inline namespace kernel
     IMPORT(SK, intern, NIL);
 
   protected:
-    let s, // stack (holding intermediate results and return address)
-        e, // environment (giving values to symbols)
-        c, // control (instructions yet to be executed)
-        d; // dump (s e c . d)
+    stack s; // stack (holding intermediate results)
+
+    let e, // environment (giving values to symbols)
+        c; // control (code being executed)
+
+    stack d; // dump (holding fp e c pc for each procedure call, and pc for each selection)
+
+    std::size_t pc = 0; // index of the next instruction in c
+
+    std::size_t fp = 0; // height of s when the current procedure was called
 
     /* ---- NOTE ---------------------------------------------------------------
      *
@@ -66,16 +81,88 @@ inline namespace kernel
       return push(global_environment(), cons(variable, std::forward<decltype(xs)>(xs)...));
     }
 
+  protected:
     /* ---- NOTE ---------------------------------------------------------------
      *
-     *  This function extends the given syntax environment 'g'. Since the order
-     *  of operand evaluation in C++ is undefined, be aware of the execution
-     *  timing of side effects of this function.
+     *  The global environment is a list of bindings that only ever grows at
+     *  its head. A binding, once made, is the location that LOAD_GLOBAL and
+     *  STORE_GLOBAL refer to for good, and any tail of the list is a snapshot
+     *  of the environment as it was (a machine forked by fork/csc starts from
+     *  one, so taking it costs nothing).
+     *
+     *  The index maps each identifier to its newest binding in the list, so
+     *  that finding a binding takes no search. It is brought up to date
+     *  lazily: only the bindings made since the head it was last brought up
+     *  to date with are indexed, or all of them if the list is not the one it
+     *  was built for.
+     *
+     *  The index refers to the bindings without owning them, but the head it
+     *  is up to date with is held, so the list they are in stays alive and
+     *  no other list can be allocated at the address of that head while the
+     *  index still compares against it.
      *
      * ---------------------------------------------------------------------- */
-    let const locate(let const& x, let & g)
+    std::unordered_map<pointer<pair>, pointer<pair>> index;
+
+    let indexed = unit; // the head of the global environment that the index is up to date with
+
+    void reindex()
     {
-      if (let const binding = assq(x, g); eq(binding, f) /* or cdr(binding).is<keyword>() */) // TODO
+      if (global_environment().get() != indexed.get())
+      {
+        std::vector<pointer<pair>> bindings;
+
+        let xs = global_environment();
+
+        for (; xs.is<pair>() and xs.get() != indexed.get(); xs = cdr(xs))
+        {
+          bindings.push_back(car(xs).get());
+        }
+
+        if (not xs.is<pair>())
+        {
+          index.clear();
+        }
+
+        std::for_each(std::rbegin(bindings), std::rend(bindings), [this](auto const binding)
+        {
+          index[std::get<0>(*binding).get()] = binding; // newer bindings are indexed later
+        });
+
+        indexed = global_environment();
+      }
+    }
+
+  public:
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Returns the binding of the identifier x in the global environment, or
+     *  #f if x is not bound.
+     *
+     * ---------------------------------------------------------------------- */
+    auto binding(let const& x) -> let
+    {
+      reindex();
+
+      if (auto const iter = index.find(x.get()); iter != std::end(index))
+      {
+        return static_cast<let>(iter->second);
+      }
+      else
+      {
+        return f;
+      }
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Returns the binding of the identifier x in the global environment,
+     *  binding x to a new location first if x is not bound.
+     *
+     * ---------------------------------------------------------------------- */
+    let const locate(let const& x)
+    {
+      if (let const binding = this->binding(x); eq(binding, f) /* or cdr(binding).is<keyword>() */) // TODO
       {
         /* ---- R7RS 5.3.1. Top level definitions ------------------------------
          *
@@ -94,7 +181,7 @@ inline namespace kernel
          *  an unbound variable.
          *
          * ------------------------------------------------------------------ */
-        return locate(x, push(g, cons(x, make<syntactic_keyword>(x, g))));
+        return car(push(global_environment(), cons(x, make<syntactic_keyword>(x, global_environment()))));
       }
       else
       {
@@ -102,9 +189,249 @@ inline namespace kernel
       }
     }
 
-    auto current_continuation() const
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Returns the value x is bound to in the global environment, or x itself
+     *  if it is not bound (see syntactic_keyword::lookup).
+     *
+     * ---------------------------------------------------------------------- */
+    auto lookup(let const& x) -> let const&
+    {
+      if (let const binding = this->binding(x); binding != f)
+      {
+        return cdr(binding);
+      }
+      else
+      {
+        return x.is<syntactic_keyword>() ? x.as<syntactic_keyword>().lookup() : x;
+      }
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Interrupts posted by the collector or by signal handlers are served at
+     *  the next procedure call.
+     *
+     * ---------------------------------------------------------------------- */
+    void interrupt(int const interrupts, std::size_t & n)
+    {
+      if (interrupts & collector::heap_dump)
+      {
+        dump_heap(heap_dump_path());
+      }
+
+      if (interrupts & collector::heap_exhaustion)
+      {
+        raise_heap_exhausted(n);
+      }
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  When the heap runs over its limit, the error is raised at the next
+     *  procedure call, where the registers are consistent: the callee is
+     *  replaced with raise, applied to an error object. A primitive procedure
+     *  that fails to allocate, or throws an error, is treated as if it had
+     *  called raise itself, so that the error can be handled in Scheme.
+     *
+     *     (callee a1 ... an . S) E (CALL n . C) D
+     *  => (raise  error     . S) E (CALL 1 . C) D
+     *
+     *  where n is the number of the operands of the call, that is replaced.
+     *  Until raise is defined, the error is thrown on instead.
+     *
+     * ---------------------------------------------------------------------- */
+    auto raise(let const& x, std::size_t & n) -> bool
+    {
+      if (let const binding = this->binding(intern("raise")); binding.is<pair>())
+      {
+        s.drop(n + 1);
+        s.push(x, cdr(binding));
+        n = 1;
+        return true;
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    void raise_heap_exhausted(std::size_t & n)
+    {
+      if (not raise(make<error>(make<string>("heap exhausted"), unit), n))
+      {
+        throw heap_exhausted();
+      }
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Applies a primitive procedure to the n operands under the top of the
+     *  stack s. A procedure of fixed arity that takes n arguments is given
+     *  copies of them, and any other is given a list of them. The operands
+     *  are not passed where they are because a procedure that reenters the
+     *  machine (eval, for example) may grow the stack and move its cells.
+     *
+     * ---------------------------------------------------------------------- */
+    auto invoke(procedure const& callee, std::size_t const n) -> let
+    {
+      switch (n)
+      {
+      case 0:
+        if (auto const f = std::get_if<procedure::nullary>(&callee.entry); f)
+        {
+          return (*f)();
+        }
+        break;
+
+      case 1:
+        if (auto const f = std::get_if<procedure::unary>(&callee.entry); f)
+        {
+          let const a1 = s[1];
+          return (*f)(a1);
+        }
+        break;
+
+      case 2:
+        if (auto const f = std::get_if<procedure::binary>(&callee.entry); f)
+        {
+          let const a1 = s[1], a2 = s[2];
+          return (*f)(a1, a2);
+        }
+        break;
+
+      case 3:
+        if (auto const f = std::get_if<procedure::ternary>(&callee.entry); f)
+        {
+          let const a1 = s[1], a2 = s[2], a3 = s[3];
+          return (*f)(a1, a2, a3);
+        }
+        break;
+
+      case 4:
+        if (auto const f = std::get_if<procedure::quaternary>(&callee.entry); f)
+        {
+          let const a1 = s[1], a2 = s[2], a3 = s[3], a4 = s[4];
+          return (*f)(a1, a2, a3, a4);
+        }
+        break;
+
+      default:
+        break;
+      }
+
+      return callee(s.list(1, n + 1));
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Spreads the list of operands of a call written with a dotted list of
+     *  operands over the stack, as if they had been pushed one by one.
+     *
+     *     (callee (a1 ... an) . S)
+     *  => (callee  a1 ... an  . S)
+     *
+     *  and returns n.
+     *
+     * ---------------------------------------------------------------------- */
+    auto spread() -> std::size_t
     {
-      return make<continuation>(s, cons(e, cadr(c), d));
+      let const callee = s[0], operands = s[1];
+
+      std::size_t n = 0;
+
+      for (let xs = operands; xs.is<pair>(); xs = cdr(xs))
+      {
+        ++n;
+      }
+
+      s.drop(2);
+
+      for (auto index = n; 0 < index; --index)
+      {
+        s.push(unit);
+      }
+
+      std::size_t index = 0;
+
+      for (let xs = operands; xs.is<pair>(); xs = cdr(xs))
+      {
+        s[index++] = car(xs);
+      }
+
+      s.push(callee);
+
+      return n;
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  A continuation copies the stacks s and d into lists, so capturing one
+     *  takes time proportional to their heights, but procedure calls that do
+     *  not capture one allocate nothing for the registers.
+     *
+     * ---------------------------------------------------------------------- */
+    auto current_continuation(let const& c, std::size_t const pc) const
+    {
+      return make<continuation>(s.list(), cons(e, c, make<exact_integer>(pc), make<exact_integer>(fp), d.list()));
+    }
+
+    void resume(continuation const& k)
+    {
+      s.assign(k.s());
+      e = k.e();
+      c = k.c();
+      pc = k.pc();
+      fp = k.fp();
+      d.assign(k.d());
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  A call of one of these primitive procedures through a global variable,
+     *  with as many operands as given here, is compiled into an instruction
+     *  of its own that does not make a list of the operands. The instruction
+     *  refers to the binding and to the procedure, and makes the call as CALL
+     *  does if the variable has since been bound to something else.
+     *
+     * ---------------------------------------------------------------------- */
+    static auto primitive(let const& applicant, let const& operands) -> std::optional<mnemonic>
+    {
+      static std::unordered_map<std::string, std::pair<mnemonic, std::size_t>> const primitives
+      {
+        { "+",     { mnemonic::ADD2,   2 } },
+        { "-",     { mnemonic::SUB2,   2 } },
+        { "<",     { mnemonic::NUMLT2, 2 } },
+        { "=",     { mnemonic::NUMEQ2, 2 } },
+        { "car",   { mnemonic::CAR,    1 } },
+        { "cdr",   { mnemonic::CDR,    1 } },
+        { "eq?",   { mnemonic::EQ,     2 } },
+        { "null?", { mnemonic::NULLP,  1 } },
+      };
+
+      if (applicant.is<procedure>())
+      {
+        if (auto const iter = primitives.find(applicant.as<procedure>().name); iter != std::end(primitives))
+        {
+          auto const [code, arity] = iter->second;
+
+          std::size_t size = 0;
+
+          let xs = operands;
+
+          for (; xs.is<pair>(); xs = cdr(xs))
+          {
+            ++size;
+          }
+
+          if (xs.is<null>() and size == arity)
+          {
+            return code;
+          }
+        }
+      }
+
+      return std::nullopt;
     }
 
     /* ---- R7RS 4. Expressions ------------------------------------------------
@@ -166,7 +493,7 @@ inline namespace kernel
             if (index.is_variadic())
             {
               WRITE_DEBUG(expression, faint, " ; is a <variadic bound variable> references ", reset, index);
-              return cons(make<instruction>(mnemonic::LOAD_VARIADIC), index, continuation);
+              return cons(make<instruction>(mnemonic::LOAD_LOCAL), index, continuation);
             }
             else
             {
@@ -182,7 +509,7 @@ inline namespace kernel
           else
           {
             WRITE_DEBUG(expression, faint, " ; is a <free variable>");
-            return cons(make<instruction>(mnemonic::LOAD_GLOBAL), locate(expression, current_syntactic_continuation.global_environment()), continuation);
+            return cons(make<instruction>(mnemonic::LOAD_GLOBAL), current_syntactic_continuation.locate(expression), continuation);
           }
         }
         else // is <self-evaluating>
@@ -193,7 +520,7 @@ inline namespace kernel
       }
       else // is (applicant . arguments)
       {
-        if (let const& applicant = lookup(car(expression), current_syntactic_continuation.global_environment()); not de_bruijn_index(car(expression), frames))
+        if (let const& applicant = current_syntactic_continuation.lookup(car(expression)); not de_bruijn_index(car(expression), frames))
         {
           if (applicant.is<syntax>())
           {
@@ -217,6 +544,21 @@ inline namespace kernel
 
             return compile(in_context_free, current_syntactic_continuation, result, frames, continuation);
           }
+          else if (auto const code = primitive(applicant, cdr(expression)); code and car(expression).is<symbol>())
+          {
+            WRITE_DEBUG(magenta, "(", reset, car(expression), faint, " ; is <primitive procedure call>") >> indent::width;
+
+            let result = cons(make<instruction>(*code), current_syntactic_continuation.locate(car(expression)), applicant, continuation);
+
+            for (let const& each : cdr(expression)) // the first operand is on the top of the stack
+            {
+              result = compile(in_context_free, current_syntactic_continuation, each, frames, result);
+            }
+
+            WRITE_DEBUG(magenta, ")") << indent::width;
+
+            return result;
+          }
         }
 
         /* ---- R7RS 4.1.3. Procedure calls ------------------------------------
@@ -260,18 +602,40 @@ inline namespace kernel
 
         WRITE_DEBUG(magenta, "(", reset, faint, " ; is <procedure call>") >> indent::width;
 
-        let const result =
-          operand(in_context_free,
-                  current_syntactic_continuation,
-                  cdr(expression),
-                  frames,
-                  compile(in_context_free,
-                          current_syntactic_continuation,
-                          car(expression),
-                          frames,
-                          cons(make<instruction>(the_expression_is.in_a_tail_context() ? mnemonic::TAIL_CALL
-                                                                                       : mnemonic::     CALL),
-                               continuation)));
+        auto const call = make<instruction>(the_expression_is.in_a_tail_context() ? mnemonic::TAIL_CALL : mnemonic::CALL);
+
+        std::size_t n = 0; // the number of the operands
+
+        let xs = cdr(expression);
+
+        for (; xs.is<pair>(); xs = cdr(xs))
+        {
+          ++n;
+        }
+
+        let result = unit;
+
+        if (xs.is<null>()) // the operands are left on the stack, the first on the top
+        {
+          result = compile(in_context_free, current_syntactic_continuation, car(expression), frames, cons(call, make<exact_integer>(n), continuation));
+
+          for (let const& each : cdr(expression))
+          {
+            result = compile(in_context_free, current_syntactic_continuation, each, frames, result);
+          }
+        }
+        else // the operands of (<operator> <operand 1> ... . <operands>) are made into a list
+        {
+          result = operand(in_context_free,
+                           current_syntactic_continuation,
+                           cdr(expression),
+                           frames,
+                           compile(in_context_free,
+                                   current_syntactic_continuation,
+                                   car(expression),
+                                   frames,
+                                   cons(call, f, continuation)));
+        }
 
         WRITE_DEBUG(magenta, ")") << indent::width;
 
@@ -279,118 +643,243 @@ inline namespace kernel
       }
     }
 
-    template <bool Trace = false>
+    /* ---- Dispatch -----------------------------------------------------------
+     *
+     *  Where the compiler supports labels as values (GCC and Clang), execute
+     *  threads each code object the first time it runs (see code::thread),
+     *  and each instruction jumps to the next one through its handler address
+     *  in the code, rather than through a shared switch. Defining
+     *  MEEVAX_SWITCH_DISPATCH, or running in trace mode or in profile mode,
+     *  dispatches every instruction by the switch instead.
+     *
+     * ---------------------------------------------------------------------- */
+    #if defined(__GNUC__) and not defined(MEEVAX_SWITCH_DISPATCH)
+    #define MEEVAX_THREADED_DISPATCH
+    #endif
+
+    #ifdef MEEVAX_THREADED_DISPATCH
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wpedantic" // labels as values
+    #pragma GCC diagnostic ignored "-Wunused-label" // dispatch, out of trace mode and profile mode
+    #endif
+
+    template <bool Trace = false, bool Profile = false>
     let execute()
     {
+      #ifdef MEEVAX_THREADED_DISPATCH
+      #define HANDLER(_, __, NAME) &&NAME,
+
+      static void * const handlers[] { BOOST_PP_SEQ_FOR_EACH(HANDLER, _, MNEMONICS) };
+
+      #undef HANDLER
+
+      #define INSTRUCTION(NAME) case mnemonic::NAME: NAME
+
+      #define NEXT if constexpr (Trace or Profile) goto dispatch; else goto *reinterpret_cast<void *>((*program)[pc])
+      #else
+      #define INSTRUCTION(NAME) case mnemonic::NAME
+
+      #define NEXT goto dispatch
+      #endif
+
+      auto load = [](let const& c)
+      {
+        auto const program = &c.as<code>();
+
+        #ifdef MEEVAX_THREADED_DISPATCH
+        if constexpr (not Trace and not Profile)
+        {
+          program->thread(handlers);
+        }
+        #endif
+
+        return program;
+      };
+
+      auto program = load(c);
+
+      /* ---- NOTE -------------------------------------------------------------
+       *
+       *  The instructions for primitive procedures (see machine::primitive)
+       *  take a fast path only while the binding they were compiled from still
+       *  holds the primitive, and only for the operands the fast path knows.
+       *  Otherwise the call is made in the general way: the operands are left
+       *  where they are, under the callee, as for CALL.
+       *
+       * -------------------------------------------------------------------- */
+      auto inlined = [&]()
+      {
+        return cdr(program->constant((*program)[pc + 1])).get() == program->constant((*program)[pc + 2]).get();
+      };
+
+      auto fixnums = [this]()
+      {
+        return tag_of(s[0].get()) == tag<exact_integer>::value and tag_of(s[1].get()) == tag<exact_integer>::value;
+      };
+
+      auto flonums = [this]()
+      {
+        return s[0].is<double_float>() and s[1].is<double_float>();
+      };
+
+      std::size_t n = 0; // the number of the operands of the procedure call being made
+
+      std::size_t next = 0; // the index of the instruction that the call returns to
+
+      /* ---- NOTE -------------------------------------------------------------
+       *
+       *  A call made in place of an inlined primitive has no inline cache of
+       *  its own, nor has any call made in trace mode or profile mode, where
+       *  code is not threaded and so must not be cached for threaded dispatch.
+       *  Such calls fill and use a cache of the machine, which is refilled on
+       *  every call.
+       *
+       * -------------------------------------------------------------------- */
+      code::cache uncached;
+
+      code::cache * site = &uncached; // the inline cache of the call being made
+
+      auto resolve = [&](code::cache & cache, let const& callee)
+      {
+        cache.callee = callee.get();
+        cache.epoch = gc.free_epoch();
+        cache.body = callee.is<closure>() ? load(car(callee)) : nullptr;
+        cache.primitive = callee.is<procedure>() ? &callee.as<procedure>() : nullptr;
+      };
+
+      auto cache_of = [&](std::size_t const index) -> code::cache &
+      {
+        if constexpr (Trace or Profile)
+        {
+          return uncached;
+        }
+        else
+        {
+          return program->caches[index];
+        }
+      };
+
     dispatch:
       if constexpr (Trace)
       {
-        std::cerr << faint << header("trace s") << reset <<  s << "\n"
+        std::cerr << faint << header("trace s") << reset <<  s.list() << "\n"
                   << faint << header("      e") << reset <<  e << "\n"
-                  << faint << header("      c") << reset <<  c << "\n"
-                  << faint << header("      d") << reset <<  d << "\n" << std::endl;
+                  << faint << header("      c") << reset <<  c << " " << pc << " " << program->opcode(pc) << "\n"
+                  << faint << header("      d") << reset <<  d.list() << "\n" << std::endl;
       }
 
-      switch (car(c).template as<instruction>().code)
+      if constexpr (Profile)
       {
-      case mnemonic::LOAD_LOCAL: /* --------------------------------------------
+        profile::count(program->opcode(pc));
+      }
+
+      switch (program->opcode(pc))
+      {
+      INSTRUCTION(LOAD_LOCAL): /* ----------------------------------------------
         *
-        *               S  E (LOAD-LOCAL (i . j) . C) D
-        *  => (result . S) E                       C  D
+        *               S  E (LOAD-LOCAL i j . C) D
+        *  => (result . S) E                   C  D
         *
-        *  where result = (list-ref (list-ref E i) j)
+        *  where result = the j-th value of the i-th frame of E
         *
-        *    i = (caadr c)
-        *    j = (cdadr c)
+        * ------------------------------------------------------------------- */
+        s.push(frame::of(e).outer((*program)[pc + 1])[(*program)[pc + 2]]);
+        pc += 3;
+        NEXT;
+
+      INSTRUCTION(LOAD_CONSTANT): /* -------------------------------------------
+        *
+        *                 S  E (LOAD-CONSTANT k . C) D
+        *  => (constant . S) E                    C  D
         *
         * ------------------------------------------------------------------- */
-        s = cons(list_ref(list_ref(e, caadr(c)), cdadr(c)), s);
-        c = cddr(c);
-        goto dispatch;
+        s.push(program->constant((*program)[pc + 1]));
+        pc += 2;
+        NEXT;
 
-      case mnemonic::LOAD_VARIADIC: /* -----------------------------------------
+      INSTRUCTION(LOAD_CONSTANT_LOCAL): /* -------------------------------------
         *
-        *               S  E (LOAD-VARIADIC (i . j) . C) D
-        *  => (result . S) E                          C  D
+        *                        S  E (LOAD-CONSTANT x LOAD-LOCAL (i . j) . C) D
+        *  => (result constant . S) E                                       C  D
         *
-        *  where result = (list-tail (list-ref E i) j)
+        *  where x = constant k, result = the j-th value of the i-th frame of E
         *
         * ------------------------------------------------------------------- */
-        s = cons(list_tail(list_ref(e, caadr(c)), cdadr(c)), s);
-        c = cddr(c);
-        goto dispatch;
+        s.push(program->constant((*program)[pc + 1]));
+        s.push(frame::of(e).outer((*program)[pc + 2])[(*program)[pc + 3]]);
+        pc += 4;
+        NEXT;
 
-      case mnemonic::LOAD_CONSTANT: /* -----------------------------------------
+      INSTRUCTION(LOAD_LOCAL_LOCAL): /* ----------------------------------------
+        *
+        *                       S  E (LOAD-LOCAL (i . j) LOAD-LOCAL (i' . j') . C) D
+        *  => (result' result . S) E                                            C  D
         *
-        *                 S  E (LOAD-CONSTANT constant . C) D
-        *  => (constant . S) E                           C  D
+        *  where result = the j-th value of the i-th frame of E, and likewise
         *
         * ------------------------------------------------------------------- */
-        s = cons(cadr(c), s);
-        c = cddr(c);
-        goto dispatch;
-
-      // case mnemonic::LOAD_SYNTAX: /* -------------------------------------------
-      //   *
-      //   *                 S  E (LOAD-SYNTAX syntax . C) D
-      //   *  => (constant . S) E                       C  D
-      //   *
-      //   * ------------------------------------------------------------------- */
-      //   push(s, cadr(c));
-      //   pop<2>(c);
-      //   goto dispatch;
+        s.push(frame::of(e).outer((*program)[pc + 1])[(*program)[pc + 2]]);
+        s.push(frame::of(e).outer((*program)[pc + 3])[(*program)[pc + 4]]);
+        pc += 5;
+        NEXT;
 
-      case mnemonic::LOAD_GLOBAL: /* -------------------------------------------
+      INSTRUCTION(LOAD_GLOBAL): /* ---------------------------------------------
         *
-        *               S  E (LOAD-GLOBAL cell . C) D
-        *  => (object . S) E                     C  D
+        *               S  E (LOAD-GLOBAL k . C) D
+        *  => (object . S) E                  C  D
+        *
+        *  where (identifier . object) = constant k
         *
         * ------------------------------------------------------------------- */
-        s = cons(cdadr(c), s);
-        c = cddr(c);
-        goto dispatch;
+        s.push(cdr(program->constant((*program)[pc + 1])));
+        pc += 2;
+        NEXT;
 
-      case mnemonic::STRIP: /* -------------------------------------------------
+      INSTRUCTION(STRIP): /* ---------------------------------------------------
+        *
+        *             S  E (STRIP k . C) D
+        *  => (form . S) E            C  D
         *
-        *             S  E (STRIP identifier . C) D
-        *  => (form . S) E                     C  D
+        *  where identifier = constant k
         *
         * ------------------------------------------------------------------- */
-        s = cons(cadr(c).template as<syntactic_keyword>().lookup(), s);
-        c = cddr(c);
-        goto dispatch;
+        s.push(program->constant((*program)[pc + 1]).template as<syntactic_keyword>().lookup());
+        pc += 2;
+        NEXT;
 
-      case mnemonic::LOAD_CLOSURE: /* ------------------------------------------
+      INSTRUCTION(LOAD_CLOSURE): /* --------------------------------------------
+        *
+        *                S  E (LOAD-CLOSURE k . C) D
+        *  => (closure . S) E                   C  D
         *
-        *                S  E (LOAD-CLOSURE body . C) D
-        *  => (closure . S) E                      C  D
+        *  where closure = (body . E), body = constant k
         *
         * ------------------------------------------------------------------- */
-        s = cons(make<closure>(cadr(c), e), s);
-        c = cddr(c);
-        goto dispatch;
+        s.push(make<closure>(program->constant((*program)[pc + 1]), e));
+        pc += 2;
+        NEXT;
 
-      case mnemonic::LOAD_CONTINUATION: /* -------------------------------------
+      INSTRUCTION(LOAD_CONTINUATION): /* ---------------------------------------
         *
-        *                       s  e (LDK cc . c) d
-        *  => ((continuation) . s) e           c  d
+        *                     s  e (LDK l . c) d
+        *  => (continuation . s) e          c  d
         *
-        *  where continuation = (s e c . d)
+        *  where continuation = (s e c l fp . d)
         *
         * ------------------------------------------------------------------- */
-        s = cons(list(current_continuation()), s);
-        c = cddr(c);
-        goto dispatch;
+        s.push(current_continuation(c, (*program)[pc + 1]));
+        pc += 2;
+        NEXT;
 
-      case mnemonic::FORK: /* --------------------------------------------------
+      INSTRUCTION(FORK): /* ----------------------------------------------------
         *
         *          s  e (FORK k . c) d
         *  => (p . s) e           c  d
         *
-        *  where k = (<program declaration> . <frames>)
+        *  where constant k = (<program declaration> . <frames>)
         *
         * ------------------------------------------------------------------- */
-        if (let const module = make<SK>(current_continuation(), global_environment()); module.is<SK>())
+        if (let const module = make<SK>(current_continuation(program->constant((*program)[pc + 1]), pc + 2), global_environment()); module.is<SK>())
         {
           /* ---- NOTE ---------------------------------------------------------
            *
@@ -402,201 +891,572 @@ inline namespace kernel
           module.as<SK>().boot(std::integral_constant<std::size_t, 0>());
           module.as<SK>().build();
 
-          s = cons(module, s);
-          c = cddr(c);
+          s.push(module);
+          pc += 2;
         }
         else
         {
           // TODO ERROR
         }
-        goto dispatch;
+        NEXT;
 
-      case mnemonic::SELECT: /* ------------------------------------------------
+      INSTRUCTION(SELECT): /* --------------------------------------------------
         *
-        *     (test . S) E (SELECT consequent alternate . C)  D
-        *  =>         S  E         selection             (C . D)
+        *     (test . S) E (SELECT l l' . C)        D
+        *  =>         S  E          selection (C . D)
         *
-        *  where selection = (if test consequent alternate)
+        *  where selection = (if test l l')
+        *
+        *  Only the index of C is pushed, since a selection returns to the code
+        *  it was selected from.
         *
         * ------------------------------------------------------------------- */
-        d = cons(cdddr(c), d);
+        d.push(make<exact_integer>(pc + 3));
         [[fallthrough]];
 
-      case mnemonic::TAIL_SELECT: /* -------------------------------------------
+      INSTRUCTION(TAIL_SELECT): /* ---------------------------------------------
         *
-        *     (test . S) E (SELECT consequent alternate . C)  D
-        *  =>         S  E         selection                  D
+        *     (test . S) E (TAIL-SELECT l l' . C) D
+        *  =>         S  E            selection   D
         *
-        *  where selection = (if test consequent alternate)
+        *  where selection = (if test l l')
         *
         * ------------------------------------------------------------------- */
-        c = car(s).template is<null>() or (car(s) != f) ? cadr(c) : caddr(c);
-        s = cdr(s);
-        goto dispatch;
+        pc = s[0].template is<null>() or (s[0] != f) ? (*program)[pc + 1] : (*program)[pc + 2];
+        s.drop();
+        NEXT;
 
-      case mnemonic::JOIN: /* --------------------------------------------------
+      INSTRUCTION(JOIN): /* ----------------------------------------------------
         *
         *     S E (JOIN) (C . D)
         *  => S E         C   D
         *
         * ------------------------------------------------------------------- */
-        c = car(d);
-        d = cdr(d);
-        goto dispatch;
+        pc = unbox(d[0].get());
+        d.drop();
+        NEXT;
+
+      INSTRUCTION(DEFINE): /* --------------------------------------------------
+        *
+        *     (x . S) E (DEFINE k . C) D
+        *  => (x . S) E             C  D
+        *
+        *  where (identifier . <unknown>) = constant k
+        *
+        * ------------------------------------------------------------------- */
+        cdr(program->constant((*program)[pc + 1])) = s[0];
+        pc += 2;
+        NEXT;
 
-      case mnemonic::DEFINE: /* ------------------------------------------------
+      INSTRUCTION(ADD2): /* ----------------------------------------------------
         *
-        *     (x . S) E (DEFINE cell . C) D
-        *  => (x . S) E                C  D
+        *     (a b . S) E (ADD2 k k' . C) D
+        *  => (x   . S) E              C  D
         *
-        *  where cell = (identifier . <unknown>)
+        *  where x = (+ a b), binding = constant k, primitive = constant k'
         *
         * ------------------------------------------------------------------- */
-        cdadr(c) = car(s);
-        c = cddr(c);
-        goto dispatch;
+        if (inlined() and fixnums())
+        {
+          s[1] = make<exact_integer>(std::int64_t(unbox(s[0].get())) + unbox(s[1].get()));
+        }
+        else if (inlined() and flonums())
+        {
+          s[1] = make<double_float>(s[0].as<double_float>().value + s[1].as<double_float>().value);
+        }
+        else
+        {
+          n = 2;
+          goto uninline;
+        }
+        s.drop();
+        pc += 3;
+        NEXT;
 
-      case mnemonic::CALL: /* --------------------------------------------------
+      INSTRUCTION(SUB2): /* ----------------------------------------------------
         *
+        *     (a b . S) E (SUB2 k k' . C) D
+        *  => (x   . S) E              C  D
+        *
+        *  where x = (- a b), binding = constant k, primitive = constant k'
         *
         * ------------------------------------------------------------------- */
-        if (let const& callee = car(s); callee.is<closure>()) // (closure operands . S) E (CALL . C) D
+        if (inlined() and fixnums())
+        {
+          s[1] = make<exact_integer>(std::int64_t(unbox(s[0].get())) - unbox(s[1].get()));
+        }
+        else if (inlined() and flonums())
         {
-          d = cons(cddr(s), e, cdr(c), d);
+          s[1] = make<double_float>(s[0].as<double_float>().value - s[1].as<double_float>().value);
+        }
+        else
+        {
+          n = 2;
+          goto uninline;
+        }
+        s.drop();
+        pc += 3;
+        NEXT;
+
+      INSTRUCTION(NUMEQ2): /* --------------------------------------------------
+        *
+        *     (a b . S) E (NUMEQ2 k k' . C) D
+        *  => (x   . S) E                C  D
+        *
+        *  where x = (= a b), binding = constant k, primitive = constant k'
+        *
+        * ------------------------------------------------------------------- */
+        if (inlined() and fixnums())
+        {
+          s[1] = s[0].get() == s[1].get() ? t : f;
+        }
+        else if (inlined() and flonums())
+        {
+          s[1] = s[0].as<double_float>().value == s[1].as<double_float>().value ? t : f;
+        }
+        else
+        {
+          n = 2;
+          goto uninline;
+        }
+        s.drop();
+        pc += 3;
+        NEXT;
+
+      INSTRUCTION(NUMLT2): /* --------------------------------------------------
+        *
+        *     (a b . S) E (NUMLT2 k k' . C) D
+        *  => (x   . S) E                C  D
+        *
+        *  where x = (< a b), binding = constant k, primitive = constant k'
+        *
+        * ------------------------------------------------------------------- */
+        if (inlined() and fixnums())
+        {
+          s[1] = unbox(s[0].get()) < unbox(s[1].get()) ? t : f;
+        }
+        else if (inlined() and flonums())
+        {
+          s[1] = s[0].as<double_float>().value < s[1].as<double_float>().value ? t : f;
+        }
+        else
+        {
+          n = 2;
+          goto uninline;
+        }
+        s.drop();
+        pc += 3;
+        NEXT;
+
+      INSTRUCTION(EQ): /* ------------------------------------------------------
+        *
+        *     (a b . S) E (EQ k k' . C) D
+        *  => (x   . S) E            C  D
+        *
+        *  where x = (eq? a b), binding = constant k, primitive = constant k'
+        *
+        * ------------------------------------------------------------------- */
+        if (inlined())
+        {
+          s[1] = s[0] == s[1] ? t : f;
+        }
+        else
+        {
+          n = 2;
+          goto uninline;
+        }
+        s.drop();
+        pc += 3;
+        NEXT;
+
+      INSTRUCTION(CAR): /* -----------------------------------------------------
+        *
+        *     (a . S) E (CAR k k' . C) D
+        *  => (x . S) E             C  D
+        *
+        *  where x = (car a), binding = constant k, primitive = constant k'
+        *
+        * ------------------------------------------------------------------- */
+        if (inlined())
+        {
+          s[0] = car(s[0]);
+        }
+        else
+        {
+          n = 1;
+          goto uninline;
+        }
+        pc += 3;
+        NEXT;
+
+      INSTRUCTION(CDR): /* -----------------------------------------------------
+        *
+        *     (a . S) E (CDR k k' . C) D
+        *  => (x . S) E             C  D
+        *
+        *  where x = (cdr a), binding = constant k, primitive = constant k'
+        *
+        * ------------------------------------------------------------------- */
+        if (inlined())
+        {
+          s[0] = cdr(s[0]);
+        }
+        else
+        {
+          n = 1;
+          goto uninline;
+        }
+        pc += 3;
+        NEXT;
+
+      INSTRUCTION(NULLP): /* ---------------------------------------------------
+        *
+        *     (a . S) E (NULLP k k' . C) D
+        *  => (x . S) E               C  D
+        *
+        *  where x = (null? a), binding = constant k, primitive = constant k'
+        *
+        * ------------------------------------------------------------------- */
+        if (inlined())
+        {
+          s[0] = s[0].is<null>() ? t : f;
+        }
+        else
+        {
+          n = 1;
+          goto uninline;
+        }
+        pc += 3;
+        NEXT;
+
+      uninline: /* -------------------------------------------------------------
+        *
+        *        (a1 ... an . S) E (OP k k' . C) D
+        *  => (callee a1 ... an . S) E (CALL n . C) D
+        *
+        *  where callee = (cdr (constant k))
+        *
+        * ------------------------------------------------------------------- */
+        s.push(cdr(program->constant((*program)[pc + 1])));
+        site = &uncached;
+        next = pc + 3;
+        goto call;
+
+      INSTRUCTION(CALL_GLOBAL): /* ---------------------------------------------
+        *
+        *              S  E (LOAD-GLOBAL k CALL n . C) D
+        *  => (callee . S) E                (CALL n . C) D
+        *
+        *  where (identifier . callee) = constant k
+        *
+        * ------------------------------------------------------------------- */
+        s.push(cdr(program->constant((*program)[pc + 1])));
+        n = (*program)[pc + 2];
+        site = &cache_of((*program)[pc + 3]);
+        next = pc + 4;
+        goto call;
+
+      INSTRUCTION(TAIL_CALL_GLOBAL): /* ----------------------------------------
+        *
+        *              S  E (LOAD-GLOBAL k TAIL-CALL n . C) D
+        *  => (callee . S) E                (TAIL-CALL n . C) D
+        *
+        *  where (identifier . callee) = constant k
+        *
+        * ------------------------------------------------------------------- */
+        s.push(cdr(program->constant((*program)[pc + 1])));
+        n = (*program)[pc + 2];
+        site = &cache_of((*program)[pc + 3]);
+        next = pc + 4;
+        goto tail_call;
+
+      INSTRUCTION(CALL): /* ----------------------------------------------------
+        *
+        *     (closure a1 ... an . S) E (CALL n . C)                    D
+        *  =>                      () E'       C' (fp E (CALL n . C) . D)
+        *
+        *  where closure = (C' . E''), E' = (frame . E'') binding a1 ... an
+        *
+        *     (procedure a1 ... an . S) E (CALL n . C) D
+        *  =>              (result . S) E           C  D
+        *
+        *  where result = the procedure applied to a1 ... an
+        *
+        *  The operands are left on the stack, the first under the callee, and
+        *  made into a list only for the rest parameter of a closure or for a
+        *  procedure that takes a list (see meevax/kernel/procedure.hpp). n is
+        *  not a count for a call written with a dotted list of operands, whose
+        *  operands are evaluated into a list, which is spread here. While the
+        *  callee is the one that the call made last, what it is is taken from
+        *  the inline cache of the call (see code::cache).
+        *
+        * ------------------------------------------------------------------- */
+        n = (*program)[pc + 1];
+        site = &cache_of((*program)[pc + 2]);
+        next = pc + 3;
+
+      call:
+        if (n == operand_list)
+        {
+          n = spread();
+        }
+
+        if (auto const interrupts = gc.interrupted(); interrupts)
+        {
+          interrupt(interrupts, n);
+        }
+
+        if (site == &uncached or site->callee != s[0].get() or site->epoch != gc.free_epoch())
+        {
+          resolve(*site, s[0]);
+        }
+
+        if (let const& callee = s[0]; site->body)
+        {
+          auto const body = site->body;
+          d.push(make<exact_integer>(fp), e, c, make<exact_integer>(next));
+          e = make_frame(body->arity, body->variadic, s, n, cdr(callee));
           c = car(callee);
-          e = cons(cadr(s), cdr(callee));
-          s = unit;
+          pc = 0;
+          s.drop(n + 1);
+          fp = s.size();
+          program = body;
         }
-        else if (callee.is<procedure>()) // (procedure operands . S) E (CALL . C) D => (result . S) E C D
+        else if (site->primitive)
         {
-          s = cons(std::invoke(callee.as<procedure>(), cadr(s)), cddr(s));
-          c = cdr(c);
+          try
+          {
+            s[n] = invoke(*site->primitive, n);
+            s.drop(n);
+          }
+          catch (heap_exhausted const&)
+          {
+            raise_heap_exhausted(n);
+            goto call; // retry
+          }
+          catch (error const& e)
+          {
+            if (raise(make<error>(car(e), cdr(e)), n))
+            {
+              goto call;
+            }
+
+            throw;
+          }
+          catch (std::exception const& e)
+          {
+            if (raise(make<error>(make<string>(e.what()), unit), n))
+            {
+              goto call;
+            }
+
+            throw;
+          }
+          pc = next;
         }
         else if (callee.is<continuation>()) /* ---------------------------------
         *
-        *     (k operands . s)  e (CALL . c) d
-        *  =>   (operand  . s') e'        c' d'
+        *     (k a1 ... an . s)  e (CALL n . c) d
+        *  =>         (a1 . s') e'           c' d'
         *
-        *  where k = (s' e' c' . 'd)
+        *  where k = (s' e' c' pc' fp' . d')
         *
         * ------------------------------------------------------------------- */
         {
-          s = cons(caadr(s), callee.as<continuation>().s());
-          e =                callee.as<continuation>().e();
-          c =                callee.as<continuation>().c();
-          d =                callee.as<continuation>().d();
+          let const operand = 0 < n ? s[1] : unit;
+          resume(callee.as<continuation>());
+          s.push(operand);
+          program = load(c);
         }
         else
         {
           throw error(make<string>("not applicable"), callee);
         }
-        goto dispatch;
+        NEXT;
 
-      case mnemonic::TAIL_CALL: /* ---------------------------------------------
+      INSTRUCTION(TAIL_CALL): /* -----------------------------------------------
+        *
+        *     (closure a1 ... an . S) E (TAIL-CALL n . C) D
+        *  =>                      () E'                C' D
         *
+        *  where closure = (C' . E''), E' = (frame . E'') binding a1 ... an, and
+        *  S is dropped down to the frame pointer
+        *
+        *  Otherwise as CALL.
         *
         * ------------------------------------------------------------------- */
-        if (let const& callee = car(s); callee.is<closure>()) // (closure operands . S) E (CALL . C) D
+        n = (*program)[pc + 1];
+        site = &cache_of((*program)[pc + 2]);
+        next = pc + 3;
+
+      tail_call:
+        if (n == operand_list)
         {
+          n = spread();
+        }
+
+        if (auto const interrupts = gc.interrupted(); interrupts)
+        {
+          interrupt(interrupts, n);
+        }
+
+        if (site == &uncached or site->callee != s[0].get() or site->epoch != gc.free_epoch())
+        {
+          resolve(*site, s[0]);
+        }
+
+        if (let const& callee = s[0]; site->body)
+        {
+          auto const body = site->body;
+          e = make_frame(body->arity, body->variadic, s, n, cdr(callee));
           c = car(callee);
-          e = cons(cadr(s), cdr(callee));
-          s = unit;
+          pc = 0;
+          s.drop(s.size() - fp);
+          program = body;
         }
-        else if (callee.is<procedure>()) // (procedure operands . S) E (CALL . C) D => (result . S) E C D
+        else if (site->primitive)
         {
-          s = cons(std::invoke(callee.as<procedure>(), cadr(s)), cddr(s));
-          c = cdr(c);
+          try
+          {
+            s[n] = invoke(*site->primitive, n);
+            s.drop(n);
+          }
+          catch (heap_exhausted const&)
+          {
+            raise_heap_exhausted(n);
+            goto tail_call; // retry
+          }
+          catch (error const& e)
+          {
+            if (raise(make<error>(car(e), cdr(e)), n))
+            {
+              goto tail_call;
+            }
+
+            throw;
+          }
+          catch (std::exception const& e)
+          {
+            if (raise(make<error>(make<string>(e.what()), unit), n))
+            {
+              goto tail_call;
+            }
+
+            throw;
+          }
+          pc = next;
         }
-        else if (callee.is<continuation>()) // (continuation operands . S) E (CALL . C) D
+        else if (callee.is<continuation>())
         {
-          s = cons(caadr(s), callee.as<continuation>().s());
-          e =                callee.as<continuation>().e();
-          c =                callee.as<continuation>().c();
-          d =                callee.as<continuation>().d();
+          let const operand = 0 < n ? s[1] : unit;
+          resume(callee.as<continuation>());
+          s.push(operand);
+          program = load(c);
         }
         else
         {
           throw error(make<string>("not applicable"), callee);
         }
-        goto dispatch;
+        NEXT;
 
-      case mnemonic::RETURN: /* ------------------------------------------------
+      INSTRUCTION(RETURN): /* --------------------------------------------------
+        *
+        *     (result . S)  E (RETURN . C) (fp' E' C' pc' . D)
+        *  => (result . S') E'          C'                  D
         *
-        *     (result . S)  E (RETURN . C) (S' E' C' . D)
-        *  => (result . S') E'          C'             D
+        *  where S' is s below fp
         *
         * ------------------------------------------------------------------- */
-        s = cons(car(s), pop(d));
-        e = pop(d);
-        c = pop(d);
-        goto dispatch;
-
-      case mnemonic::CONS: /* --------------------------------------------------
+        s.unwind(fp);
+        pc = unbox(d[0].get());
+        c = d[1];
+        e = d[2];
+        fp = unbox(d[3].get());
+        d.drop(4);
+        program = load(c);
+        NEXT;
+
+      INSTRUCTION(CONS): /* ----------------------------------------------------
         *
         *     ( X   Y  . S) E (CONS . C) D
         *  => ((X . Y) . S) E         C  D
         *
         * ------------------------------------------------------------------- */
-        s = cons(cons(car(s), cadr(s)), cddr(s));
-        c = cdr(c);
-        goto dispatch;
+        s[1] = cons(s[0], s[1]);
+        s.drop();
+        pc += 1;
+        NEXT;
 
-      case mnemonic::DROP: /* --------------------------------------------------
+      INSTRUCTION(DROP): /* ----------------------------------------------------
         *
         *    (result . S) E (DROP . C) D
         *  =>          S  E         C  D
         *
         * ------------------------------------------------------------------- */
-        s = cdr(s);
-        c = cdr(c);
-        goto dispatch;
+        s.drop();
+        pc += 1;
+        NEXT;
 
-      case mnemonic::STORE_GLOBAL: /* ------------------------------------------
+      INSTRUCTION(STORE_GLOBAL): /* --------------------------------------------
         *
-        *     (value . S) E (STORE-GLOBAL cell . C) D
-        *  => (value . S) E                      C  D
+        *     (value . S) E (STORE-GLOBAL k . C) D
+        *  => (value . S) E                   C  D
         *
-        *  where cell = (identifier . x)
+        *  where (identifier . x) = constant k
         *
         * ------------------------------------------------------------------- */
-        if (let const& binding = cadr(c); cdr(binding).is<null>())
+        if (let const& binding = program->constant((*program)[pc + 1]); cdr(binding).is<null>())
         {
-          cdr(binding) = car(s);
+          cdr(binding) = s[0];
         }
         else
         {
-          cdr(binding).store(car(s));
+          cdr(binding).store(s[0]);
         }
-        c = cddr(c);
-        goto dispatch;
+        pc += 2;
+        NEXT;
 
-      case mnemonic::STORE_LOCAL: /* -------------------------------------------
+      INSTRUCTION(STORE_LOCAL): /* ---------------------------------------------
+        *
+        *     (value . S) E (STORE-LOCAL i j . C) D
+        *  => (value . S) E                    C  D
         *
-        *     (value . S) E (STORE-LOCAL (i . j) . C) D
-        *  => (value . S) E                        C  D
+        *  where value is stored to the j-th cell of the i-th frame of E
         *
         * ------------------------------------------------------------------- */
-        car(list_tail(list_ref(e, caadr(c)), cdadr(c))).store(car(s));
-        c = cddr(c);
-        goto dispatch;
-
-      case mnemonic::STORE_VARIADIC:
-        cdr(list_tail(list_ref(e, caadr(c)), cdadr(c))).store(car(s));
-        c = cddr(c);
-        goto dispatch;
+        frame::of(e).outer((*program)[pc + 1])[(*program)[pc + 2]].store(s[0]);
+        pc += 3;
+        NEXT;
 
       default: // ERROR
-      case mnemonic::STOP: /* --------------------------------------------------
+      INSTRUCTION(STOP): /* ----------------------------------------------------
         *
         *     (result . S) E (STOP . C) D
         *  =>           S  E         C  D
         *
         * ------------------------------------------------------------------- */
-        c = cdr(c);
-        return pop(s); // return car(s);
+        pc += 1;
+        {
+          let const result = s.pop();
+
+          if (s.empty()) // at the outermost level, release what a deep recursion left
+          {
+            s.shrink(1024);
+            d.shrink(1024);
+          }
+
+          return result;
+        }
       }
+
+      #undef INSTRUCTION
+      #undef NEXT
     }
 
+    #ifdef MEEVAX_THREADED_DISPATCH
+    #pragma GCC diagnostic pop
+    #endif
+
   protected: // PRIMITIVE EXPRESSION TYPES
     SYNTAX(quotation) /* -------------------------------------------------------
     *
@@ -690,7 +1550,7 @@ inline namespace kernel
 
         if (car(expression).is<pair>()) // (define (f . <formals>) <body>)
         {
-          let const g = locate(caar(expression), current_syntactic_continuation.global_environment());
+          let const g = current_syntactic_continuation.locate(caar(expression));
 
           return compile(in_context_free,
                          current_syntactic_continuation,
@@ -700,7 +1560,7 @@ inline namespace kernel
         }
         else // (define x ...)
         {
-          let const g = locate(car(expression), current_syntactic_continuation.global_environment());
+          let const g = current_syntactic_continuation.locate(car(expression));
 
           return compile(in_context_free,
                          current_syntactic_continuation,
@@ -935,6 +1795,7 @@ inline namespace kernel
       WRITE_DEBUG(car(expression), faint, " ; is <formals>");
 
       return cons(make<instruction>(mnemonic::LOAD_CLOSURE),
+                  car(expression),
                   body(the_expression_is,
                        current_syntactic_continuation,
                        cdr(expression),
@@ -958,7 +1819,7 @@ inline namespace kernel
                           current_syntactic_continuation,
                           car(expression),
                           frames,
-                          cons(make<instruction>(mnemonic::CALL), continuation)));
+                          cons(make<instruction>(mnemonic::CALL), make<exact_integer>(1), continuation)));
     }
 
     SYNTAX(fork) /* ------------------------------------------------------------
@@ -1001,7 +1862,7 @@ inline namespace kernel
                          current_syntactic_continuation,
                          cadr(expression),
                          frames,
-                         cons(make<instruction>(mnemonic::STORE_VARIADIC), index, continuation));
+                         cons(make<instruction>(mnemonic::STORE_LOCAL), index, continuation));
         }
         else
         {
@@ -1018,7 +1879,7 @@ inline namespace kernel
       {
         WRITE_DEBUG(car(expression), faint, "; is a <free variable>");
 
-        let const g = locate(car(expression), current_syntactic_continuation.global_environment());
+        let const g = current_syntactic_continuation.locate(car(expression));
 
         if (the_expression_is.at_the_top_level() and cdr(g).is<syntactic_keyword>())
         {
@@ -1055,7 +1916,7 @@ inline namespace kernel
         if (variable.is_variadic())
         {
           WRITE_DEBUG(car(expression), faint, " ; is <identifier> of local variadic ", reset, variable);
-          return cons(make<instruction>(mnemonic::LOAD_VARIADIC), variable, continuation);
+          return cons(make<instruction>(mnemonic::LOAD_LOCAL), variable, continuation);
         }
         else
         {
@@ -1066,7 +1927,7 @@ inline namespace kernel
       else
       {
         WRITE_DEBUG(car(expression), faint, " ; is <identifier> of free variable");
-        return cons(make<instruction>(mnemonic::LOAD_GLOBAL), locate(car(expression), current_syntactic_continuation.global_environment()), continuation);
+        return cons(make<instruction>(mnemonic::LOAD_GLOBAL), current_syntactic_continuation.locate(car(expression)), continuation);
       }
     }
 
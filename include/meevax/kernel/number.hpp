@@ -15,7 +15,7 @@ namespace meevax
 {
 inline namespace kernel
 {
-  auto make_number = [](auto&& z)
+  inline auto make_number = [](auto&& z)
   {
     if constexpr (std::is_same<typename std::decay<decltype(z)>::type, ratio>::value)
     {
@@ -394,7 +394,7 @@ inline namespace kernel
     }
   }
 
-  auto exact = [](let const& z)
+  inline auto exact = [](let const& z)
   {
     static std::unordered_map<
       std::type_index, std::function<let (let const&)>> const overloads
@@ -408,7 +408,7 @@ inline namespace kernel
     return resolve(overloads, z);
   };
 
-  auto inexact = [](let const& z)
+  inline auto inexact = [](let const& z)
   {
     static std::unordered_map<
       std::type_index, std::function<let (let const&)>> const overloads
@@ -422,7 +422,7 @@ inline namespace kernel
     return resolve(overloads, z);
   };
 
-  auto is_nan = [](let const& x)
+  inline auto is_nan = [](let const& x)
   {
     static std::unordered_map<
       std::type_index, std::function<bool (let const&)>> const overloads
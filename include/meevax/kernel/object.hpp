@@ -79,7 +79,7 @@ inline namespace kernel
   template <typename T> using is_object    = std::is_base_of<                       let       , typename std::decay<T>::type>;
   template <typename T> using is_reference = std::is_base_of<std::reference_wrapper<let const>, typename std::decay<T>::type>;
 
-  auto unwrap = [](auto&& x) -> decltype(auto)
+  inline auto unwrap = [](auto&& x) -> decltype(auto)
   {
     if constexpr (is_object<decltype(x)>::value)
     {
@@ -23,6 +23,17 @@ inline namespace kernel
     {}
 
     virtual ~pair() = default;
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  A pair is eqv? only to itself. Comparing the cars and cdrs would make
+     *  two pairs of the same fixnums eqv?, since fixnums are immediate.
+     *
+     * ---------------------------------------------------------------------- */
+    bool eqv(let const& x) const override
+    {
+      return this == x.get();
+    }
   };
 
   auto operator <<(output_port & port, pair const&) -> output_port &;
@@ -30,11 +41,12 @@ inline namespace kernel
   /* ---- Pair Accessor --------------------------------------------------------
    *
    *  Pair accessors are not only for pair type. Accessing car and cdr is a
-   *  valid operation for everyone except the empty list.
+   *  valid operation for everyone except the empty list and immediate values
+   *  (see meevax/kernel/heterogeneous.hpp).
    *
    * ------------------------------------------------------------------------ */
-  auto car = [](auto&& x) noexcept -> decltype(auto) { return std::get<0>(unwrap(std::forward<decltype(x)>(x))); };
-  auto cdr = [](auto&& x) noexcept -> decltype(auto) { return std::get<1>(unwrap(std::forward<decltype(x)>(x))); };
+  inline auto car = [](auto&& x) -> decltype(auto) { return std::get<0>(unwrap(std::forward<decltype(x)>(x))); };
+  inline auto cdr = [](auto&& x) -> decltype(auto) { return std::get<1>(unwrap(std::forward<decltype(x)>(x))); };
 } // namespace kernel
 } // namespace meevax
 
@@ -7,7 +7,7 @@ namespace meevax
 {
 inline namespace kernel
 {
-  auto char_eq = [](auto c, auto... cs) constexpr
+  inline auto char_eq = [](auto c, auto... cs) constexpr
   {
     return (std::char_traits<decltype(c)>::eq(c, cs) or ...);
   };
@@ -22,22 +22,22 @@ inline namespace kernel
    *
    * ------------------------------------------------------------------------ */
 
-  auto is_intraline_whitespace = [](auto c) constexpr
+  inline auto is_intraline_whitespace = [](auto c) constexpr
   {
     return char_eq(c, ' ', '\f', '\t', '\v');
   };
 
-  auto is_end_of_line = [](auto c) constexpr
+  inline auto is_end_of_line = [](auto c) constexpr
   {
     return char_eq(c, '\n', '\r');
   };
 
-  auto is_eof = [](auto c) constexpr
+  inline auto is_eof = [](auto c) constexpr
   {
     return char_eq(c, std::char_traits<decltype(c)>::eof());
   };
 
-  auto is_whitespace = [](auto c) constexpr
+  inline auto is_whitespace = [](auto c) constexpr
   {
     return is_intraline_whitespace(c) or is_end_of_line(c) or is_eof(c);
   };
@@ -50,12 +50,12 @@ inline namespace kernel
    *
    * ------------------------------------------------------------------------ */
 
-  auto is_vertical_line = [](auto c) constexpr
+  inline auto is_vertical_line = [](auto c) constexpr
   {
     return char_eq(c, '|');
   };
 
-  auto is_delimiter = [](auto c) constexpr
+  inline auto is_delimiter = [](auto c) constexpr
   {
     return is_whitespace(c)
         or is_vertical_line(c)
@@ -69,12 +69,12 @@ inline namespace kernel
    *
    * ------------------------------------------------------------------------ */
 
-  auto is_reader_macro_introducer = [](auto c) constexpr
+  inline auto is_reader_macro_introducer = [](auto c) constexpr
   {
     return char_eq(c, '#', '\'', '`', ',');
   };
 
-  auto is_end_of_token = [](auto c) constexpr
+  inline auto is_end_of_token = [](auto c) constexpr
   {
     return is_delimiter(c) or is_reader_macro_introducer(c);
   };
@@ -1,8 +1,11 @@
 #ifndef INCLUDED_MEEVAX_KERNEL_PROCEDURE_HPP
 #define INCLUDED_MEEVAX_KERNEL_PROCEDURE_HPP
 
+#include <array>
 #include <numeric> // std::accumulate
+#include <variant>
 
+#include <meevax/kernel/error.hpp>
 #include <meevax/kernel/linker.hpp>
 #include <meevax/kernel/list.hpp>
 
@@ -16,19 +19,89 @@ inline namespace kernel
   #define PROCEDURE(...) meevax::let const __VA_ARGS__(                 meevax::let const& xs)
   #endif
 
+  /* ---- Procedure ------------------------------------------------------------
+   *
+   *  A native procedure takes the list of its operands. It may instead be
+   *  defined with a fixed arity of 0 to 4, as a function (or a lambda
+   *  expression that captures nothing) of as many arguments, as in
+   *
+   *    define<procedure>("cons", procedure::fixed<2>, [](let const& a, let const& b)
+   *    {
+   *      return cons(a, b);
+   *    });
+   *
+   *  The machine passes the operands of a call with as many operands to such
+   *  a procedure as references into its stack, without making a list. A call
+   *  with any other number of operands, or a call through the list entry,
+   *  takes the operands from the list as for a closure: too few operands are
+   *  an error, and operands in excess are ignored.
+   *
+   *  A function of fixed arity is given its arguments where they are, so it
+   *  must not run the machine, which may move the stack.
+   *
+   * ------------------------------------------------------------------------ */
   struct procedure : public std::function<PROCEDURE()>
   {
     using signature = PROCEDURE((*));
 
+    using nullary    = let (*)();
+    using unary      = let (*)(let const&);
+    using binary     = let (*)(let const&, let const&);
+    using ternary    = let (*)(let const&, let const&, let const&);
+    using quaternary = let (*)(let const&, let const&, let const&, let const&);
+
+    template <std::size_t N>
+    static constexpr std::integral_constant<std::size_t, N> fixed {};
+
     std::string const name;
 
+    using entries = std::variant<std::monostate, nullary, unary, binary, ternary, quaternary>;
+
+    entries const entry; // of fixed arity, if any
+
     template <typename... Ts>
     explicit procedure(std::string const& name, Ts&&... xs)
       : std::function<PROCEDURE()> { std::forward<decltype(xs)>(xs)...  }
       , name { name }
     {}
 
+    template <std::size_t N, typename F>
+    explicit procedure(std::string const& name, std::integral_constant<std::size_t, N>, F&& f)
+      : procedure { name, static_cast<std::variant_alternative_t<N + 1, entries>>(f), std::make_index_sequence<N>() }
+    {}
+
     virtual ~procedure() = default;
+
+  private:
+    template <typename F, std::size_t... Is>
+    explicit procedure(std::string const& name, F const f, std::index_sequence<Is...> indices)
+      : std::function<PROCEDURE()> { [f, indices](let const& xs) { return apply(f, xs, indices); } }
+      , name { name }
+      , entry { f }
+    {}
+
+    template <typename F, std::size_t... Is>
+    static auto apply(F const f, let const& xs, std::index_sequence<Is...>) -> let
+    {
+      std::array<let, sizeof...(Is)> arguments {};
+
+      let ys = xs;
+
+      for (auto & argument : arguments)
+      {
+        if (ys.is<pair>())
+        {
+          argument = car(ys);
+          ys = cdr(ys);
+        }
+        else
+        {
+          throw error(make<string>("too few arguments"), xs);
+        }
+      }
+
+      return f(std::get<Is>(arguments)...);
+    }
   };
 
   auto operator <<(output_port & port, procedure const& datum) -> output_port &;
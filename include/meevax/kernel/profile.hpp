@@ -0,0 +1,64 @@
+#ifndef INCLUDED_MEEVAX_KERNEL_PROFILE_HPP
+#define INCLUDED_MEEVAX_KERNEL_PROFILE_HPP
+
+#include <vector>
+
+#include <meevax/kernel/instruction.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  /* ---- Profile --------------------------------------------------------------
+   *
+   *  In profile mode, the machine counts the instructions that it executes,
+   *  and the sequences of two and of three of them in the order executed,
+   *  to find the sequences worth fusing into a superinstruction. Sequences
+   *  are counted across calls and returns too, although only those within
+   *  straight-line code can be fused.
+   *
+   *  The counts are shared by every machine in the process, and written by
+   *  report, which --profile registers to run at exit.
+   *
+   * ------------------------------------------------------------------------ */
+  struct profile
+  {
+    static constexpr std::size_t size = BOOST_PP_SEQ_SIZE(MNEMONICS);
+
+    static inline std::vector<std::size_t> unigrams = std::vector<std::size_t>(size);
+
+    static inline std::vector<std::size_t> bigrams = std::vector<std::size_t>(size * size);
+
+    static inline std::vector<std::size_t> trigrams = std::vector<std::size_t>(size * size * size);
+
+    static inline std::size_t history = 0; // the number of the instructions counted so far, up to 2
+
+    static inline std::size_t previous = 0; // the last two opcodes, as the index of a bigram
+
+    static void count(mnemonic const code) noexcept
+    {
+      auto const m = static_cast<std::size_t>(code);
+
+      ++unigrams[m];
+
+      if (1 < history)
+      {
+        ++trigrams[previous * size + m];
+      }
+
+      if (0 < history)
+      {
+        ++bigrams[previous % size * size + m];
+      }
+
+      previous = previous % size * size + m;
+
+      history = std::min<std::size_t>(history + 1, 2);
+    }
+
+    static void report();
+  };
+} // namespace kernel
+} // namespace meevax
+
+#endif // INCLUDED_MEEVAX_KERNEL_PROFILE_HPP
@@ -12,9 +12,9 @@ inline namespace kernel
   {
     using pair::pair;
 
-    auto numerator() const -> exact_integer const&;
+    auto numerator() const -> exact_integer;
 
-    auto denominator() const -> exact_integer const&;
+    auto denominator() const -> exact_integer;
 
     auto is_integer() const -> bool;
 
@@ -1,12 +1,161 @@
 #ifndef INCLUDED_MEEVAX_KERNEL_STACK_HPP
 #define INCLUDED_MEEVAX_KERNEL_STACK_HPP
 
+#include <vector>
+
 #include <meevax/kernel/list.hpp>
 
 namespace meevax
 {
 inline namespace kernel
 {
+  /* ---- Stack ----------------------------------------------------------------
+   *
+   *  A contiguous stack of cells, for the registers of the machine. The cells
+   *  are held in memory owned by a standard container, so they are roots. A
+   *  slot is cleared when popped and reused by the next push, so pushing and
+   *  popping only store into a cell, and the root table changes only when
+   *  the stack grows past its highest mark or is shrunk.
+   *
+   *  Indexing counts from the top. A stack is saved (by a continuation, for
+   *  example) as a list whose car is the top, and restored from one.
+   *
+   * ------------------------------------------------------------------------ */
+  class stack
+  {
+    std::vector<let> data;
+
+    std::size_t height = 0;
+
+  public:
+    auto size() const noexcept
+    {
+      return height;
+    }
+
+    auto empty() const noexcept
+    {
+      return height == 0;
+    }
+
+    auto operator [](std::size_t const index) noexcept -> let &
+    {
+      return data[height - 1 - index];
+    }
+
+    auto operator [](std::size_t const index) const noexcept -> let const&
+    {
+      return data[height - 1 - index];
+    }
+
+    void push(let const& x)
+    {
+      if (height < std::size(data))
+      {
+        data[height] = x;
+      }
+      else
+      {
+        data.push_back(x);
+      }
+
+      ++height;
+    }
+
+    template <typename... Ts>
+    void push(let const& x, Ts&&... xs)
+    {
+      push(x);
+      push(std::forward<decltype(xs)>(xs)...);
+    }
+
+    auto pop() -> let
+    {
+      let const x = data[--height];
+      data[height] = unit;
+      return x;
+    }
+
+    void drop(std::size_t const n = 1)
+    {
+      for (auto const base = height - n; base < height; )
+      {
+        data[--height] = unit;
+      }
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Drops everything above the given height but the top.
+     *
+     * ---------------------------------------------------------------------- */
+    void unwind(std::size_t const base)
+    {
+      if (base + 1 < height)
+      {
+        data[base] = data[height - 1];
+        drop(height - base - 1);
+      }
+    }
+
+    void shrink(std::size_t const capacity)
+    {
+      if (height <= capacity and capacity < std::size(data))
+      {
+        data.erase(std::next(std::begin(data), capacity), std::end(data));
+        data.shrink_to_fit();
+      }
+    }
+
+    auto list() const
+    {
+      let xs = unit;
+
+      for (std::size_t index = 0; index < height; ++index)
+      {
+        xs = cons(data[index], xs);
+      }
+
+      return xs;
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Copies the cells from the index first up to the index last (exclusive)
+     *  into a list, the first at the head, as the operands of a procedure
+     *  call are made into one.
+     *
+     * ---------------------------------------------------------------------- */
+    auto list(std::size_t const first, std::size_t const last) const
+    {
+      let xs = unit;
+
+      for (auto index = last; first < index; --index)
+      {
+        xs = cons((*this)[index - 1], xs);
+      }
+
+      return xs;
+    }
+
+    void assign(let const& xs)
+    {
+      drop(height);
+
+      for (let x = xs; x.is<pair>(); x = cdr(x))
+      {
+        push(unit);
+      }
+
+      std::size_t index = height;
+
+      for (let x = xs; x.is<pair>(); x = cdr(x))
+      {
+        data[--index] = car(x);
+      }
+    }
+  };
+
   template <typename T, typename... Ts>
   inline decltype(auto) push(T&& stack, Ts&&... xs)
   {
@@ -7,7 +7,7 @@ namespace meevax
 {
 inline namespace kernel
 {
-  using characters = std::vector<character>;
+  using characters = std::vector<character, collector::allocator<character>>;
 
   /* ---- R7RS 6.7. Strings ----------------------------------------------------
    *
@@ -39,7 +39,25 @@ inline namespace kernel
       ~initializer();
     };
 
-    static inline std::unordered_map<std::string, let> symbols;
+    /* ---- Symbol Table -------------------------------------------------------
+     *
+     *  The symbol table refers to each symbol by an ephemeron without a datum,
+     *  so a symbol that is no longer referred to by anything else is collected
+     *  and interned afresh the next time it is read. Since nothing can tell
+     *  the new symbol from the old one, eq? on symbols is unaffected. Broken
+     *  entries are removed when the table has grown to twice its size after
+     *  the last removal.
+     *
+     *  The table is shared by the syntactic continuations of every thread, and
+     *  is locked while interning. The lock is taken in a safe region, because
+     *  the thread holding it may allocate and so wait for a collection.
+     *
+     * ---------------------------------------------------------------------- */
+    static inline std::unordered_map<std::string, collector::ephemeron> symbols;
+
+    static inline std::mutex symbols_mutex;
+
+    static inline std::size_t symbols_purge_at = 1024;
 
     static inline std::unordered_map<std::string, let> external_symbols; // TODO REMOVE
 
@@ -72,7 +90,7 @@ inline namespace kernel
        *  argument.
        *
        *  The car part contains the registers of the virtual Lisp machine
-       *  (s e c . d). The cdr part is set to the global environment at the
+       *  (s e c pc fp . d). The cdr part is set to the global environment at the
        *  time the FORK instruction was executed.
        *
        *  Here, the value in the c register is the operand of the FORK
@@ -95,10 +113,17 @@ inline namespace kernel
 
         auto const& k = std::get<0>(*this).as<continuation>();
 
-        s = k.s();
+        /* ---- NOTE -----------------------------------------------------------
+         *
+         *  The stacks are not resumed: the program runs to its STOP on empty
+         *  stacks, and the cells of a stack are roots, so a copy of the stacks
+         *  of the machine that forked this one would keep them alive as long
+         *  as this one.
+         *
+         * ------------------------------------------------------------------ */
         e = k.e();
-        c = compile(at_the_top_level, *this, car(k.c()), cdr(k.c()));
-        d = k.d();
+        c = assemble(compile(at_the_top_level, *this, car(k.c()), cdr(k.c())));
+        pc = 0;
 
         form() = execute();
 
@@ -122,19 +147,34 @@ inline namespace kernel
       return cdr(form());
     }
 
-    let static const& intern(std::string const& s)
+    static auto intern(std::string const& s) -> let
     {
-      if (auto const iter = symbols.find(s); iter != std::end(symbols))
+      auto const lock = [] { collector::safe_region const _; return std::unique_lock(symbols_mutex); }();
+
+      if (auto const iter = symbols.find(s); iter != std::end(symbols) and not iter->second.broken())
       {
-        return cdr(*iter);
+        return static_cast<let>(static_cast<pair *>(iter->second.key()));
       }
-      else if (auto const [position, success] = symbols.emplace(s, make<symbol>(s)); success)
+      else if (let const x = make<symbol>(s); iter != std::end(symbols))
       {
-        return cdr(*position);
+        iter->second.reset(x.get());
+        return x;
       }
       else
       {
-        throw error(make<string>("failed to intern a symbol"), unit);
+        symbols.try_emplace(s, x.get());
+
+        if (symbols_purge_at <= std::size(symbols))
+        {
+          for (auto iter = std::begin(symbols); iter != std::end(symbols); )
+          {
+            iter = iter->second.broken() ? symbols.erase(iter) : std::next(iter);
+          }
+
+          symbols_purge_at = std::max<std::size_t>(std::size(symbols) * 2, 1024);
+        }
+
+        return x;
       }
     }
 
@@ -154,10 +194,16 @@ inline namespace kernel
     {
       static constexpr auto trace = true;
 
+      static constexpr auto profile = true;
+
       if (in_trace_mode())
       {
         return machine::execute<trace>();
       }
+      else if (in_profile_mode())
+      {
+        return machine::execute<not trace, profile>();
+      }
       else
       {
         return machine::execute();
@@ -168,10 +214,24 @@ inline namespace kernel
     {
       ++generation;
 
-      // XXX ???
-      push(d, s, e, cons(make<instruction>(mnemonic::STOP), c));
+      /* ---- NOTE -------------------------------------------------------------
+       *
+       *  The macro transformer is the body of a closure, which returns to
+       *  the frame pushed here as if by CALL: a STOP instruction, which
+       *  returns the result of the expansion. RETURN restores fp and e, and
+       *  the code being executed when the macro was invoked is restored after
+       *  the STOP.
+       *
+       * -------------------------------------------------------------------- */
+      let static const stop = assemble(list(make<instruction>(mnemonic::STOP)));
+
+      let const caller = c;
 
-      s = unit;
+      auto const caller_pc = pc;
+
+      d.push(make<exact_integer>(fp), e, stop, make<exact_integer>(0));
+
+      fp = s.size();
 
       // TODO (3)
       // make<procedure>("rename", [this](auto&& xs)
@@ -181,10 +241,9 @@ inline namespace kernel
       //
       // });
 
-      e = cons(
-            // form, // <lambda> parameters
-            cons(keyword, cdr(form)),
-            dynamic_environment());
+      auto const& transformer = current_expression().as<code>();
+
+      e = make_frame(transformer.arity, transformer.variadic, cons(keyword, cdr(form)), dynamic_environment());
       // TODO (4)
       // => e = cons(
       //          list(
@@ -202,7 +261,15 @@ inline namespace kernel
 
       c = current_expression();
 
-      return execute();
+      pc = 0;
+
+      let const result = execute();
+
+      c = caller;
+
+      pc = caller_pc;
+
+      return result;
     }
 
     auto evaluate(let const& expression)
@@ -212,7 +279,20 @@ inline namespace kernel
         write_to(standard_debug_port(), "\n"); // Blank for compiler's debug-mode prints
       }
 
-      c = compile(in_context_free, *this, expression);
+      /* ---- NOTE -------------------------------------------------------------
+       *
+       *  Procedures such as eval and load call evaluate while the machine is
+       *  running, so the code being executed is restored afterwards. The
+       *  evaluated code leaves s, e and d as it found them.
+       *
+       * -------------------------------------------------------------------- */
+      let const caller = c;
+
+      auto const caller_pc = pc;
+
+      c = assemble(compile(in_context_free, *this, expression));
+
+      pc = 0;
 
       if (in_debug_mode())
       {
@@ -220,7 +300,13 @@ inline namespace kernel
         disassemble(standard_debug_port().as<output_port>(), c);
       }
 
-      return execute();
+      let const result = execute();
+
+      c = caller;
+
+      pc = caller_pc;
+
+      return result;
     }
 
     auto load(path const& name) -> auto const&
@@ -256,7 +342,7 @@ inline namespace kernel
 
     let const& operator [](let const& name)
     {
-      return cdr(machine::locate(name, global_environment()));
+      return cdr(machine::locate(name));
     }
 
     decltype(auto) operator [](std::string const& name)
@@ -303,7 +389,7 @@ inline namespace kernel
 
       auto exportation = [](let const& xs)
       {
-        for (auto const& each : xs)
+        for (auto const& each : car(xs))
         {
           std::cerr << ";\t\t; staging " << each << std::endl;
           external_symbols.emplace(boost::lexical_cast<std::string>(each), each);
@@ -321,7 +407,7 @@ inline namespace kernel
 
       return cons(make<instruction>(mnemonic::LOAD_CONSTANT), expression,
                   make<instruction>(mnemonic::LOAD_CONSTANT), make<procedure>("exportation", exportation),
-                  make<instruction>(mnemonic::CALL),
+                  make<instruction>(mnemonic::CALL), make<exact_integer>(1),
                   continuation);
     }
 
@@ -329,12 +415,14 @@ inline namespace kernel
     {
       auto importation = [&](let const& xs)
       {
-        assert(xs.is<syntactic_continuation>());
+        let const& x = car(xs);
+
+        assert(x.is<syntactic_continuation>());
 
-        if (xs.as<syntactic_continuation>().external_symbols.empty())
+        if (x.as<syntactic_continuation>().external_symbols.empty())
         {
-          std::cerr << "; import\t; " << xs << " is virgin => expand" << std::endl;
-          xs.as<syntactic_continuation>().macroexpand(xs, cons(xs, unit));
+          std::cerr << "; import\t; " << x << " is virgin => expand" << std::endl;
+          x.as<syntactic_continuation>().macroexpand(x, cons(x, unit));
         }
 
         // for ([[maybe_unused]] const auto& [key, value] : xs.as<syntactic_continuation>().external_symbols)
@@ -351,7 +439,7 @@ inline namespace kernel
                     expression,
                     frames,
                     cons(make<instruction>(mnemonic::LOAD_CONSTANT), make<procedure>("import", importation),
-                         make<instruction>(mnemonic::CALL),
+                         make<instruction>(mnemonic::CALL), make<exact_integer>(1),
                          continuation));
     }
   };
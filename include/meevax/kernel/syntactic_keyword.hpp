@@ -22,31 +22,17 @@ inline namespace kernel
       return std::get<1>(*this);
     }
 
-    auto assq() const -> decltype(auto)
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  A syntactic keyword is made only for an identifier that is not bound
+     *  in the global environment it is made with (see machine::locate), and
+     *  that environment only ever grows at a head the keyword does not see,
+     *  so the identifier stays free in it and looking it up takes no search.
+     *
+     * ---------------------------------------------------------------------- */
+    auto lookup() const noexcept -> let const&
     {
-      return kernel::assq(unwrap_syntax(), global_environment());
-    }
-
-    let const& lookup() const
-    {
-      if (let const& x = assq(); x != f)
-      {
-        return cdr(x);
-      }
-      else
-      {
-        return unwrap_syntax();
-      }
-    }
-
-    auto is_free() const
-    {
-      return assq().eqv(f);
-    }
-
-    auto is_bound() const
-    {
-      return not is_free();
+      return unwrap_syntax();
     }
 
     friend auto operator <<(output_port & port, syntactic_keyword const& datum) -> output_port &
@@ -54,18 +40,6 @@ inline namespace kernel
       return port << underline << datum.unwrap_syntax() << reset;
     }
   };
-
-  auto lookup(let const& x, let const& g) -> let const&
-  {
-    if (let const& p = assq(x, g); p != f)
-    {
-      return cdr(p);
-    }
-    else
-    {
-      return x.is<syntactic_keyword>() ? x.as<syntactic_keyword>().lookup() : x;
-    }
-  }
 } // namespace kernel
 } // namespace meevax
 
@@ -10,9 +10,9 @@ inline namespace kernel
   enum class for_each_in_tag {} constexpr for_each_in {};
 
   struct vector
-    : public std::vector<let>
+    : public std::vector<let, collector::allocator<let>>
   {
-    using std::vector<let>::vector;
+    using std::vector<let, collector::allocator<let>>::vector;
 
     template <typename InputIterator>
     explicit vector(for_each_in_tag, InputIterator from, InputIterator to)
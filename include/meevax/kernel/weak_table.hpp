@@ -0,0 +1,46 @@
+#ifndef INCLUDED_MEEVAX_KERNEL_WEAK_TABLE_HPP
+#define INCLUDED_MEEVAX_KERNEL_WEAK_TABLE_HPP
+
+#include <unordered_map>
+
+#include <meevax/kernel/boolean.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  /* ---- Weak Table -----------------------------------------------------------
+   *
+   *  A hash table from keys compared by eq? to values, where each entry is an
+   *  ephemeron: an entry neither keeps its key alive nor keeps its value alive
+   *  longer than its key, and it disappears once its key is collected.
+   *
+   *  Entries are keyed by the address of the key. An address may be reused
+   *  by a new object after the key is collected, so an entry only matches
+   *  while it is not broken. Broken entries are removed when the table has
+   *  grown to twice its size after the last removal.
+   *
+   * ------------------------------------------------------------------------ */
+  struct weak_table
+  {
+    std::unordered_map<std::uintptr_t, collector::ephemeron> entries;
+
+    std::size_t purge_at = 8;
+
+    auto ref(let const& key, let const& default_value) const -> let;
+
+    void set(let const& key, let const& value);
+
+    void erase(let const& key);
+
+    auto size() const -> std::size_t;
+
+  private:
+    void purge();
+  };
+
+  auto operator <<(std::ostream &, weak_table const&) -> std::ostream &;
+} // namespace kernel
+} // namespace meevax
+
+#endif // INCLUDED_MEEVAX_KERNEL_WEAK_TABLE_HPP
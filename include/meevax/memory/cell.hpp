@@ -8,8 +8,15 @@ namespace meevax
 {
 inline namespace memory
 {
+  /* ---- Cell -----------------------------------------------------------------
+   *
+   *  A reference registered with the collector. A cell is word aligned so
+   *  that it never shares a word of the page bitmap with another, which
+   *  matters when compressed references make the whole cell a single word.
+   *
+   * ------------------------------------------------------------------------ */
   template <typename T>
-  struct cell
+  struct alignas(sizeof(std::uintptr_t)) cell
     : public simple_pointer<T>
     , private collector::object
   {
@@ -23,13 +30,13 @@ inline namespace memory
 
     explicit cell(cell const& datum)
       : simple_pointer<T> { datum.get() }
-      , collector::object { simple_pointer<T>::get() }
+      , collector::object {}
     {}
 
     template <typename U>
     explicit cell(cell<U> const& datum)
       : simple_pointer<T> { datum.get() }
-      , collector::object { simple_pointer<T>::get() }
+      , collector::object {}
     {}
 
     auto operator =(cell const& another) -> auto &
@@ -48,17 +55,26 @@ inline namespace memory
       collector::object::reset(simple_pointer<T>::reset(data));
     }
 
+    /* ---- NOTE -------------------------------------------------------------
+     *
+     *  The region that another cell points to has already been assigned its
+     *  deallocator, so storing and swapping only exchange the pointers and
+     *  run the write barrier.
+     *
+     * -------------------------------------------------------------------- */
     auto store(cell const& another) -> auto &
     {
-      reset(another.get());
+      simple_pointer<T>::reset(another.get());
+      collector::object::barrier();
       return *this;
     }
 
     void swap(cell & another)
     {
       auto const copy = simple_pointer<T>::get();
-      reset(another.get());
-      another.reset(copy);
+      store(another);
+      another.simple_pointer<T>::reset(copy);
+      another.collector::object::barrier();
     }
   };
 } // namespace memory
@@ -1,16 +1,27 @@
 #ifndef INCLUDED_MEEVAX_MEMORY_COLLECTOR_HPP
 #define INCLUDED_MEEVAX_MEMORY_COLLECTOR_HPP
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <limits>
 #include <map>
 #include <mutex>
 #include <new>
 #include <set>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <meevax/memory/literal.hpp>
-#include <meevax/memory/region.hpp>
+#include <meevax/memory/page_table.hpp>
+#include <meevax/memory/registry.hpp>
+#include <meevax/memory/tagged_pointer.hpp>
 #include <meevax/string/header.hpp>
 #include <meevax/utility/debug.hpp>
 
@@ -27,191 +38,1185 @@ inline namespace memory
    *  - https://www.codeproject.com/Articles/938/A-garbage-collection-framework-for-C-Part-II
    *
    * ------------------------------------------------------------------------ */
+  struct heap_exhausted : public std::bad_alloc
+  {
+    auto what() const noexcept -> char const* override
+    {
+      return "heap exhausted";
+    }
+  };
+
   class collector
   {
   public:
     using is_always_equal = std::true_type;
 
-    struct object
+    /* ---- Object -------------------------------------------------------------
+     *
+     *  Object is the base of every cell, and is placed immediately after the
+     *  pointer that the cell holds. A cell outside the heap (on the stack, in
+     *  static storage or in memory owned by a standard container) is a root,
+     *  and registers itself in the root table of its thread (see Root Tables).
+     *  A cell inside the heap only sets its bit in the bitmap of the page, and
+     *  is found by scanning the address range of the object that contains it.
+     *
+     *  Neither storing to a cell nor registering it takes a lock or searches a
+     *  tree, so copying a cell costs one page table lookup.
+     *
+     * ---------------------------------------------------------------------- */
+    struct object
+    {
+    private:
+      #ifdef MEEVAX_COMPRESSED_REFERENCES
+      using index_type = std::uint32_t;
+      #else
+      using index_type = std::size_t;
+      #endif
+
+      static constexpr auto interior = std::numeric_limits<index_type>::max();
+
+      index_type index;
+
+      friend class collector;
+
+      /* ---- NOTE -------------------------------------------------------------
+       *
+       *  The reference of a cell is stored just before its object. The page
+       *  bitmap has a bit for each word, and reports the word that the object
+       *  is in: that is the object itself, or with compressed references the
+       *  whole cell, whose first half is the reference.
+       *
+       * -------------------------------------------------------------------- */
+      auto target() const noexcept
+      {
+        #ifdef MEEVAX_COMPRESSED_REFERENCES
+        return reinterpret_cast<pointer<void>>(decompress(*(reinterpret_cast<pointer<compressed_word const>>(this) - 1)));
+        #else
+        return *(reinterpret_cast<pointer<pointer<void> const>>(this) - 1);
+        #endif
+      }
+
+      static auto at(std::uintptr_t const address) noexcept
+      {
+        #ifdef MEEVAX_COMPRESSED_REFERENCES
+        return reinterpret_cast<pointer<object const>>(address + sizeof(compressed_word));
+        #else
+        return reinterpret_cast<pointer<object const>>(address);
+        #endif
+      }
+
+    protected:
+      explicit object()
+      {
+        if (auto const p = pages.find(reinterpret_cast<std::uintptr_t>(this)); p)
+        {
+          index = interior;
+          p->insert(reinterpret_cast<std::uintptr_t>(this));
+          collector::barrier(p, this);
+        }
+        else
+        {
+          enroll(&table::roots, this);
+        }
+      }
+
+      explicit object(pointer<void> const derived, deallocator<void>::signature const deallocate)
+        : object {}
+      {
+        collector::reset(derived, deallocate);
+      }
+
+      template <typename Pointer>
+      explicit object(Pointer const derived)
+        : object { derived, deallocator<typename std::pointer_traits<Pointer>::element_type>::deallocate }
+      {}
+
+      ~object()
+      {
+        if (index == interior)
+        {
+          if (auto const p = pages.find(reinterpret_cast<std::uintptr_t>(this)); p)
+          {
+            p->erase(reinterpret_cast<std::uintptr_t>(this));
+          }
+        }
+        else
+        {
+          withdraw(&table::roots, this);
+        }
+      }
+
+      /* ---- Write Barrier ----------------------------------------------------
+       *
+       *  Must be called after the pointer of the cell is overwritten. Only a
+       *  store into a cell inside an object can create a reference from the
+       *  old generation to the young generation, or from a black object to a
+       *  white one, so roots return at once.
+       *
+       * -------------------------------------------------------------------- */
+      void barrier()
+      {
+        if (index == interior)
+        {
+          if (auto const p = pages.find(reinterpret_cast<std::uintptr_t>(this)); p)
+          {
+            collector::barrier(p, this);
+          }
+        }
+      }
+
+      void reset(pointer<void> const derived, deallocator<void>::signature const deallocate)
+      {
+        collector::reset(derived, deallocate);
+        barrier();
+      }
+
+      template <typename Pointer>
+      void reset(Pointer const derived)
+      {
+        reset(derived, deallocator<typename std::pointer_traits<Pointer>::element_type>::deallocate);
+      }
+    };
+
+    /* ---- Ephemeron ----------------------------------------------------------
+     *
+     *  An ephemeron refers to a key and a datum without keeping either alive.
+     *  The datum is kept alive as long as the key is alive, whether or not the
+     *  ephemeron itself is, and when the key is collected the ephemeron is
+     *  broken: both references are cleared at once. An ephemeron whose datum
+     *  is null is a weak reference to its key.
+     *
+     *  Ephemerons are not cells, so they are invisible to the tracing of the
+     *  objects that contain them. Instead every ephemeron registers itself in
+     *  the ephemeron table, and once the ordinary marking is finished, the
+     *  collector shades the datum of each ephemeron whose key is marked until
+     *  no more data are shaded, then breaks the ephemerons whose keys are
+     *  unmarked (see settle). Immediate values and pointers outside the heap
+     *  are always alive.
+     *
+     *  Like roots, ephemerons are registered in the table of the thread that
+     *  creates them (see Root Tables).
+     *
+     * ---------------------------------------------------------------------- */
+    struct ephemeron
+    {
+    private:
+      pointer<void> k;
+
+      pointer<void> d;
+
+      bool b = false;
+
+      std::size_t index;
+
+      friend class collector;
+
+    public:
+      explicit ephemeron(pointer<void> const key = nullptr, pointer<void> const datum = nullptr)
+        : k { key }
+        , d { datum }
+      {
+        enroll(&table::ephemerons, this);
+      }
+
+      ephemeron(ephemeron const& other)
+        : ephemeron { other.k, other.d }
+      {
+        b = other.b;
+      }
+
+      auto operator =(ephemeron const& other) -> ephemeron &
+      {
+        k = other.k;
+        d = other.d;
+        b = other.b;
+        return *this;
+      }
+
+      ~ephemeron()
+      {
+        withdraw(&table::ephemerons, this);
+      }
+
+      auto key() const noexcept
+      {
+        return k;
+      }
+
+      auto datum() const noexcept
+      {
+        return d;
+      }
+
+      auto broken() const noexcept
+      {
+        return b;
+      }
+
+      void reset(pointer<void> const key, pointer<void> const datum = nullptr) noexcept
+      {
+        k = key;
+        d = datum;
+        b = false;
+      }
+    };
+
+    /* ---- Safe Region --------------------------------------------------------
+     *
+     *  A thread that blocks without allocating for a long time, for example to
+     *  join a thread that allocates, must do so in a safe region, so that
+     *  other threads can collect meanwhile (see Thread-Local Allocation
+     *  Buffers). The thread must not touch the heap inside the region.
+     *
+     * ---------------------------------------------------------------------- */
+    struct safe_region
+    {
+      bool const released = local and local->hold.owns_lock();
+
+      explicit safe_region()
+      {
+        if (released)
+        {
+          local->hold.unlock();
+        }
+      }
+
+      ~safe_region()
+      {
+        if (released)
+        {
+          local->hold.lock();
+        }
+      }
+    };
+
+  private:
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  The lock is recursive because it is re-entered: collect is called from
+     *  allocate, and sweeping runs destructors that may deallocate.
+     *
+     * ---------------------------------------------------------------------- */
+    static inline std::recursive_mutex resource;
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  A thread waits for the lock in a safe region, because the thread that
+     *  holds it may be stopping the world, and so waiting for the buffer of
+     *  the waiting thread.
+     *
+     * ---------------------------------------------------------------------- */
+    static auto acquire()
+    {
+      safe_region const _;
+      return std::unique_lock(resource);
+    }
+
+    /* ---- Thread-Local Allocation Buffers ------------------------------------
+     *
+     *  Each thread that allocates has a buffer: a page of its own in each size
+     *  class it allocates from, and a reserve of bytes charged to the heap in
+     *  advance. Allocation takes a slot from the page of the buffer and
+     *  records the region in the buffer, without any lock, until the reserve
+     *  runs out or the page is full. Only then does the thread take the lock
+     *  to refill the buffer, and this is where collections are triggered. The
+     *  counters of the heap are therefore exact only while no buffer holds a
+     *  reserve; the limit is checked against the reserves.
+     *
+     *  A thread holds the mutex of its buffer while it runs. It releases the
+     *  mutex while it waits for the lock in refill and inside a safe region,
+     *  and these are its safepoints. A collection, and anything else that
+     *  needs the whole heap, holds the lock and a world: the mutexes of all
+     *  other buffers, so that the other threads are stopped at safepoints.
+     *  The world then retires every buffer: its pages are released, its
+     *  regions and counts are added to the heap, and its unused reserve is
+     *  given back.
+     *
+     *  Stores into cells are not synchronized, so threads that share objects
+     *  still have to synchronize by themselves.
+     *
+     * ---------------------------------------------------------------------- */
+    struct buffer
+    {
+      std::mutex mutex;
+
+      std::unique_lock<std::mutex> hold { mutex }; // held by the owner thread while it runs
+
+      std::array<pointer<page>, large> pages {};
+
+      std::size_t reserve = 0; // bytes that may be allocated without refilling
+
+      std::size_t granted = 0; // bytes charged to the heap by the last refill
+
+      std::size_t objects = 0; // regions allocated since the last refill
+
+      std::vector<pointer<region>> young; // regions allocated since the last refill
+
+      std::vector<pointer<region>> remembered; // regions remembered by the write barrier since the last world
+
+      std::vector<pointer<region>> gray; // regions shaded by the write barrier since the last world
+    };
+
+    static constexpr std::size_t buffer_size = 64_KiB;
+
+    static inline registry<pointer<buffer>> buffers;
+
+    [[gnu::tls_model("initial-exec")]] static inline thread_local pointer<buffer> local;
+
+    struct world
+    {
+      std::vector<std::unique_lock<std::mutex>> locks;
+
+      explicit world();
+
+      ~world();
+    };
+
+    [[gnu::tls_model("initial-exec")]] static inline thread_local std::size_t stopped; // depth of nested worlds held by this thread
+
+    /* ---- Root Tables --------------------------------------------------------
+     *
+     *  Each thread registers the roots and the ephemerons that it creates in a
+     *  table of its own, by swapping them into the last slot. Only the thread
+     *  modifies its table while it runs, so this takes no lock. The number of
+     *  the table, like the other thread-local variables of the collector, uses
+     *  the initial-exec TLS model, so that reading it from the shared library
+     *  is a single load rather than a call to __tls_get_addr. The collector
+     *  reads every table under a world, while their threads are stopped at
+     *  safepoints. A root or an ephemeron records the number of its table in
+     *  the upper table_bits of its index, and its slot in the rest.
+     *
+     *  Table 0 is shared by the threads that have no table: the threads after
+     *  the first tables_max - 1, and the threads that are exiting. When a
+     *  thread exits, the entries left in its table are moved to table 0. Table
+     *  0, and the table of another thread, are modified only under the lock
+     *  and a world. Destroying a cell that another thread created, such as a
+     *  cell of an object shared by threads, therefore stops the world, unless
+     *  the thread already holds one, as the collector does while sweeping.
+     *
+     *  The write barrier likewise records remembered and shaded regions in the
+     *  buffer of its thread, and a world merges them into the remembered set
+     *  and the gray stack of the collector when it retires the buffer.
+     *
+     * ---------------------------------------------------------------------- */
+    struct table
+    {
+      registry<pointer<object>> roots;
+
+      registry<pointer<ephemeron>> ephemerons;
+    };
+
+    static constexpr std::size_t table_bits = 6;
+
+    static constexpr std::size_t tables_max = std::size_t(1) << table_bits;
+
+    template <typename Index>
+    static constexpr std::size_t slot_bits = std::numeric_limits<Index>::digits - table_bits;
+
+    static inline std::array<table, tables_max> tables;
+
+    static inline std::array<bool, tables_max> taken; // tables assigned to threads
+
+    [[gnu::tls_model("initial-exec")]] static inline thread_local std::size_t own; // the number of the table of this thread, or 0
+
+    template <typename F>
+    static void exclusively(F&& f)
+    {
+      if (stopped)
+      {
+        f();
+      }
+      else if (auto const lock = acquire(); lock)
+      {
+        world const stopped;
+        f();
+      }
+    }
+
+    template <typename T>
+    static void enroll(registry<T *> table::* const list, T * const x)
+    {
+      using index_type = decltype(x->index);
+
+      if (auto const t = own; t and std::size(tables[t].*list) < (index_type(1) << slot_bits<index_type>) - 1)
+      {
+        x->index = static_cast<index_type>(t) << slot_bits<index_type> | static_cast<index_type>((tables[t].*list).push_back(x));
+      }
+      else
+      {
+        enroll_slowly(list, x);
+      }
+    }
+
+    template <typename T>
+    static void enroll_slowly(registry<T *> table::* const, T * const);
+
+    template <typename T>
+    static void withdraw(registry<T *> table::* const list, T * const x) noexcept
+    {
+      using index_type = decltype(x->index);
+
+      if (auto const t = static_cast<std::size_t>(x->index >> slot_bits<index_type>); t and t == own)
+      {
+        remove(tables[t].*list, x);
+      }
+      else
+      {
+        withdraw_slowly(list, x);
+      }
+    }
+
+    template <typename T>
+    static void withdraw_slowly(registry<T *> table::* const, T * const) noexcept;
+
+    template <typename T>
+    static void remove(registry<T *> & entries, T * const x) noexcept
+    {
+      using index_type = decltype(x->index);
+
+      auto const last = entries.back();
+
+      entries.pop_back();
+
+      if (auto const slot = x->index & ((index_type(1) << slot_bits<index_type>) - 1); slot < std::size(entries))
+      {
+        entries[slot] = last;
+        last->index = x->index;
+      }
+    }
+
+    template <typename F>
+    static void for_each_root_cell(F&& f)
+    {
+      for (auto const& t : tables)
+      {
+        for (auto root : t.roots)
+        {
+          f(root);
+        }
+      }
+    }
+
+    template <typename F>
+    static void for_each_ephemeron(F&& f)
+    {
+      for (auto const& t : tables)
+      {
+        for (auto e : t.ephemerons)
+        {
+          f(e);
+        }
+      }
+    }
+
+    /* ---- Generations --------------------------------------------------------
+     *
+     *  Objects are not moved. A region is young until it survives its first
+     *  collection, and is then promoted to the old generation in place. The
+     *  young list holds every region allocated since the last collection, so a
+     *  minor collection marks from the roots and the remembered old objects,
+     *  stops at old objects, and sweeps only the young list. Its cost is
+     *  proportional to the roots and the live young objects, not to the whole
+     *  heap.
+     *
+     *  Between collections every live region is marked in the current phase.
+     *  A minor collection unmarks the young regions without toggling the
+     *  phase, so old regions look already marked and the traversal does not
+     *  enter them. A major collection toggles the phase and marks everything.
+     *
+     *  Regions that have not been assigned a deallocator yet are objects under
+     *  construction. They stay in the young list and are traced as roots by
+     *  both kinds of collection.
+     *
+     * ---------------------------------------------------------------------- */
+    static inline registry<pointer<region>> young;
+
+    static inline registry<pointer<region>> remembered; // old regions that may refer to young ones
+
+    /* ---- Arenas -------------------------------------------------------------
+     *
+     *  An arena is the set of pages that one thread allocates from between
+     *  open_arena and close_arena. While an arena is open, its thread takes
+     *  only pages that are empty, so that the objects of the arena are not
+     *  mixed with older ones. Closing the arena runs a minor collection, whose
+     *  trace from the roots and the remembered set finds the objects that
+     *  escaped. Each page of the arena in which nothing escaped and nothing is
+     *  to be finalized is then emptied at once, without destroying its objects
+     *  one by one, and kept as a spare page for the next arena. The objects
+     *  that escaped are promoted like any survivor of a minor collection.
+     *
+     *  Arenas nest, and belong to the thread that opened them. A major
+     *  collection may release empty pages, so the pages that an arena took
+     *  before the last major sweep are forgotten (see epoch), and so are the
+     *  spare pages. An arena that is closed while a major collection is in
+     *  progress leaves its pages to the collection.
+     *
+     * ---------------------------------------------------------------------- */
+    struct arena
+    {
+      std::array<std::vector<pointer<page>>, large + 1> pages; // for each size class, and the large pages
+
+      std::size_t epoch; // of the pages
+
+      pointer<arena> outer;
+    };
+
+    static inline std::size_t epoch; // number of major sweeps
+
+    [[gnu::tls_model("initial-exec")]] static inline thread_local pointer<arena> current;
+
+    static inline std::array<std::vector<pointer<page>>, large> spares; // pages emptied by arenas
+
+    static inline std::size_t old_size; // bytes promoted to the old generation
+
+    static inline std::size_t old_limit; // old_size that triggers a major collection
+
+    /* ---- Incremental Collection ---------------------------------------------
+     *
+     *  When a pause budget is set, a major collection is split into slices of
+     *  at most that many microseconds, run once per step_size bytes of
+     *  allocation. The marking is tri-color: marked regions in the gray stack
+     *  are gray, other marked regions are black, and unmarked regions are
+     *  white. Objects allocated during the cycle are black.
+     *
+     *  The write barrier shades the region a cell inside an object is made to
+     *  point to (Dijkstra's insertion barrier). Stores into roots have no
+     *  barrier, so when the gray stack runs dry the roots are scanned again,
+     *  and the marking finishes without a budget.
+     *
+     *  Sweeping then proceeds page by page in later slices. Minor collections
+     *  are suspended until the cycle ends. Objects allocated during sweeping
+     *  stay young, so the barrier remembers every object stored into in the
+     *  meantime, whatever its generation.
+     *
+     * ---------------------------------------------------------------------- */
+    enum class cycle
+    {
+      idle, marking, sweeping
+    };
+
+    static constexpr std::size_t step_size = 64_KiB;
+
+    static inline cycle state;
+
+    static inline std::chrono::microseconds budget;
+
+    /* ---- Mark Stack ---------------------------------------------------------
+     *
+     *  The gray stack is also the mark stack of stop-the-world collections,
+     *  so marking never recurses. It grows up to gray_limit entries (see
+     *  reset_mark_stack_limit). Beyond that, a shaded region is marked without
+     *  being pushed and the stack is flagged as overflowed. Once the stack is
+     *  drained, the marked regions are traced again to find the children such
+     *  regions left unmarked, until no overflow occurs.
+     *
+     * ---------------------------------------------------------------------- */
+    static constexpr std::size_t mark_stack_limit_default = 64 * 1024; // entries, 512 KiB
+
+    static inline std::size_t gray_limit;
+
+    static inline registry<pointer<region>> gray;
+
+    static inline bool overflowed;
+
+    static inline std::size_t step_at; // allocation at which the next slice runs
+
+    static inline std::size_t sweeping; // size class being swept
+
+    static inline pointer<pointer<page>> sweeping_link; // link to the next page to sweep
+
+    static inline pointer<page> sweeping_last; // last page kept in the size class being swept
+
+    /* ---- Lazy Sweeping and Finalization -------------------------------------
+     *
+     *  A major collection triggered by allocation only marks within its pause.
+     *  Sweeping then proceeds lazily, lazy_sweep_pages pages at each refill of
+     *  an allocation buffer, in the same way as the slices of an incremental
+     *  cycle. If the allocation crosses the threshold before the sweep is done,
+     *  the rest of the sweep runs at once.
+     *
+     *  Sweeping, whether lazy or not, frees dead objects at once only if they
+     *  are cheap to destroy. Objects marked by finalize_lazily, such as
+     *  strings, vectors and big integers that own memory outside the heap, are
+     *  put on the finalization queue instead, and at most finalization_quota
+     *  of them are destroyed and freed at each refill, so that their
+     *  destructors run outside the pauses of collections. The quota frees objects faster
+     *  than a buffer can allocate them, so the queue is normally empty by the
+     *  next collection, and any left are finalized when it starts. Until then
+     *  a queued object still occupies its slot, but is no longer counted as
+     *  live by the statistics or the heap growth.
+     *
+     *  The queue is drained at once by the public collect and collect_young,
+     *  and before anything that visits the whole heap, so that they never see
+     *  dead objects.
+     *
+     * ---------------------------------------------------------------------- */
+    static constexpr std::size_t lazy_sweep_pages = 16;
+
+    static constexpr std::size_t finalization_quota = 8192; // regions
+
+    static inline registry<pointer<region>> finalizable;
+
+    static inline std::size_t pending; // bytes of the finalizable regions
+
+    /* ---- Parallel Marking ---------------------------------------------------
+     *
+     *  A stop-the-world major collection of a large heap is marked by several
+     *  threads. Each worker traces from a private stack, and publishes half of
+     *  it to its shared deque whenever that deque is empty. A worker that runs
+     *  out of work steals half of the shared deque of another worker. Regions
+     *  are claimed by an atomic exchange of their mark bit, so each region is
+     *  traced exactly once. With a single marking thread, the heap is marked
+     *  from the gray stack like a small one.
+     *
+     * ---------------------------------------------------------------------- */
+    static constexpr std::size_t parallel_threshold = 65536; // regions
+
+    static inline std::size_t threads;
+
+    static inline page_table pages;
+
+    static inline std::array<pointer<page>, large + 1> heap; // page lists for each size class
+
+    static inline std::array<pointer<page>, large> cursor; // page to allocate from, for each size class
+
+    static inline std::array<pointer<page>, large> tail; // last page, for each size class
+
+    static inline std::size_t size; // number of allocated regions
+
+    static inline std::atomic<std::size_t> frees; // see free_epoch
+
+    static inline std::size_t allocation; // bytes allocated since the last collection
+
+    static inline std::size_t threshold; // allocation that triggers a collection
+
+    /* ---- Heap Growth --------------------------------------------------------
+     *
+     *  After each collection, the threshold is set so that the next collection
+     *  runs when the heap has grown to growth times the bytes that survived,
+     *  bounded by threshold_min and threshold_max. A small heap is then not
+     *  collected over and over, and a large heap is not collected in
+     *  proportion to the size of its live data. The old generation grows by
+     *  the same factor before a major collection.
+     *
+     *  The heap never holds more than limit bytes, plus a headroom of an
+     *  eighth of it. An allocation that would exceed the limit runs a full
+     *  collection, and if less than an eighth of the limit is left free, the
+     *  heap is overdrawn: the heap_exhaustion interrupt is posted, so that the
+     *  machine can report the condition as a Scheme error, and allocations are served
+     *  from the headroom without further collections at the limit, so that
+     *  the handler still has memory to run. Collections that bring the heap
+     *  back under seven eighths of the limit end the overdraft. Allocations
+     *  beyond the headroom throw heap_exhausted.
+     *
+     * ---------------------------------------------------------------------- */
+    static inline double growth;
+
+    static inline std::size_t threshold_min;
+
+    static inline std::size_t threshold_max;
+
+    static inline std::size_t limit;
+
+    static inline bool overdrawn; // allocating from the headroom
+
+    /* ---- Interrupts ---------------------------------------------------------
+     *
+     *  Requests for the mutator to handle at its next safe point, as a set of
+     *  bits. Posting one is async-signal-safe, and checking for them is a
+     *  single relaxed load.
+     *
+     * ---------------------------------------------------------------------- */
+    static inline std::atomic<int> interrupts;
+
+  public:
+    enum : int
+    {
+      heap_exhaustion = 1 << 0,
+      heap_dump       = 1 << 1,
+    };
+
+  public:
+    /* ---- Statistics ---------------------------------------------------------
+     *
+     *  Counters accumulated since the start of the program. Times are the
+     *  wall-clock time spent in each phase, and the times of an incremental
+     *  cycle are the sums of its slices. A pause is the time that the mutator
+     *  is stopped by one collection or one slice; pause_histogram[0] counts
+     *  pauses shorter than a microsecond, and pause_histogram[k] counts those
+     *  at least 2^(k-1) and less than 2^k microseconds long (the last bucket
+     *  also counts longer ones). The live counts are taken at the end of the
+     *  last collection. Every counter starts from zero, as the statistics are
+     *  in static storage.
+     *
+     * ---------------------------------------------------------------------- */
+    struct statistics
+    {
+      std::size_t allocated_bytes;
+
+      std::size_t allocated_objects;
+
+      std::size_t minor_collections;
+
+      std::size_t major_collections;
+
+      std::chrono::nanoseconds mark_time;
+
+      std::chrono::nanoseconds sweep_time;
+
+      std::chrono::nanoseconds last_mark_time;
+
+      std::chrono::nanoseconds last_sweep_time;
+
+      std::chrono::nanoseconds total_pause;
+
+      std::chrono::nanoseconds max_pause;
+
+      std::array<std::size_t, 24> pause_histogram;
+
+      std::size_t live_bytes;
+
+      std::size_t live_objects;
+
+      std::size_t large_object_bytes; // bytes of payloads in the large object space
+
+      std::size_t mark_stack_overflows;
+    };
+
+  private:
+    static inline statistics cumulative;
+
+    static inline std::size_t occupancy; // bytes of allocated regions and payloads
+
+    static inline std::atomic<std::size_t> released; // bytes of small payloads freed without the lock
+
+    static inline std::unordered_map<pointer<void>, std::size_t> extents; // of the payloads in the large object space
+
+    static inline std::multimap<std::size_t, pointer<void>> vacancies; // pages freed by payloads, by extent
+
+    static inline std::size_t vacant; // bytes of vacancies
+
+    static inline std::chrono::nanoseconds cycle_mark_time; // of the collection in progress
+
+    static inline std::chrono::nanoseconds cycle_sweep_time; // of the collection in progress
+
+    struct pause
+    {
+      std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+      ~pause()
+      {
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+
+        auto const microseconds = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+        auto const k = microseconds ? 64 - __builtin_clzll(microseconds) : 0;
+
+        ++cumulative.pause_histogram[std::min<std::size_t>(k, std::size(cumulative.pause_histogram) - 1)];
+
+        cumulative.total_pause += elapsed;
+
+        cumulative.max_pause = std::max<std::chrono::nanoseconds>(cumulative.max_pause, elapsed);
+      }
+    };
+
+    template <typename F>
+    static auto measure(std::chrono::nanoseconds & elapsed, F&& f)
+    {
+      auto const start = std::chrono::steady_clock::now();
+
+      if constexpr (std::is_void<decltype(f())>::value)
+      {
+        f();
+        elapsed += std::chrono::steady_clock::now() - start;
+      }
+      else
+      {
+        auto const result = f();
+        elapsed += std::chrono::steady_clock::now() - start;
+        return result;
+      }
+    }
+
+    static void retune()
+    {
+      threshold = std::clamp<std::size_t>(static_cast<std::size_t>(cumulative.live_bytes * (growth - 1)), threshold_min, std::max(threshold_min, threshold_max));
+    }
+
+    static void record(std::size_t & collections)
+    {
+      ++collections;
+
+      cumulative.mark_time += cumulative.last_mark_time = std::exchange(cycle_mark_time, std::chrono::nanoseconds(0));
+
+      cumulative.sweep_time += cumulative.last_sweep_time = std::exchange(cycle_sweep_time, std::chrono::nanoseconds(0));
+
+      occupancy -= released.exchange(0, std::memory_order_relaxed);
+
+      cumulative.live_bytes = occupancy - pending;
+
+      cumulative.live_objects = size - std::size(finalizable);
+
+      retune();
+
+      overdrawn &= limit - limit / 8 < occupancy - pending;
+    }
+
+  public:
+    explicit collector();
+
+    explicit collector(collector &&) = delete;
+
+    explicit collector(collector const&) = delete;
+
+    ~collector();
+
+    collector & operator =(collector &&) = delete;
+
+    collector & operator =(collector const&) = delete;
+
+    auto allocate(std::size_t const size) -> pointer<void>
+    {
+      if (auto const b = local; b and size < b->reserve)
+      {
+        if (auto const k = size_class_of(size); k < large and b->pages[k])
+        {
+          if (auto const r = b->pages[k]->allocate(std::max<std::size_t>(size, 1)); r)
+          {
+            b->reserve -= r->bytes();
+            b->young.push_back(r);
+            ++b->objects;
+
+            return reinterpret_cast<pointer<void>>(r->lower_bound());
+          }
+        }
+      }
+
+      return refill(size);
+    }
+
+    /* ---- Arena Scope --------------------------------------------------------
+     *
+     *  Opens an arena for the objects that the thread allocates within the
+     *  scope, and closes it at the end of the scope (see Arenas), which frees
+     *  those that are no longer reachable from any cell.
+     *
+     * ---------------------------------------------------------------------- */
+    static void open_arena();
+
+    static void close_arena();
+
+    struct arena_scope
+    {
+      explicit arena_scope()
+      {
+        open_arena();
+      }
+
+      ~arena_scope()
+      {
+        close_arena();
+      }
+    };
+
+    /* ---- Large Object Space -------------------------------------------------
+     *
+     *  Payloads are the buffers that objects in the heap own outside of their
+     *  regions, such as the elements of a vector and the characters of a
+     *  string. They are allocated through the collector, so that their bytes
+     *  count toward the threshold and the limit like those of the objects
+     *  that own them, and a payload may trigger a collection.
+     *
+     *  Payloads of at least large_payload bytes are mapped from the system in
+     *  whole pages. When one is freed, its physical memory is returned to the
+     *  system with madvise, and its pages are kept, up to vacancy_max bytes,
+     *  to map later payloads of about the same size without a system call.
+     *  Smaller payloads come from operator new, and are charged to the
+     *  reserve of the allocation buffer of the thread when it suffices.
+     *
+     *  Payloads are not scanned: the cells in a payload are roots, as they
+     *  are outside of the heap.
+     *
+     * ---------------------------------------------------------------------- */
+    static constexpr std::size_t large_payload = page_size;
+
+    static constexpr std::size_t vacancy_max = 64_MiB;
+
+    static auto allocate_payload(std::size_t const) -> pointer<void>;
+
+    static void deallocate_payload(pointer<void> const, std::size_t const) noexcept;
+
+    template <typename T>
+    struct allocator
     {
-    protected:
-      explicit constexpr object() = default;
+      using value_type = T;
 
-      explicit object(pointer<void> const derived, deallocator<void>::signature const deallocate)
-      {
-        if (auto const lock = std::unique_lock(resource); derived and lock)
-        {
-          objects.emplace(this, collector::reset(derived, deallocate));
-        }
-      }
+      allocator() = default;
 
-      template <typename Pointer>
-      explicit object(Pointer const derived)
-        : object { derived, deallocator<typename std::pointer_traits<Pointer>::element_type>::deallocate }
+      template <typename U>
+      allocator(allocator<U> const&) noexcept
       {}
 
-      ~object()
+      auto allocate(std::size_t const n) -> T *
       {
-        if (auto const lock = std::unique_lock(resource); lock)
-        {
-          objects.erase(this);
-        }
+        return static_cast<T *>(allocate_payload(n * sizeof(T)));
       }
 
-      void reset(pointer<void> const derived, deallocator<void>::signature const deallocate)
+      void deallocate(T * const data, std::size_t const n) noexcept
       {
-        if (auto const lock = std::unique_lock(resource); derived and lock)
-        {
-          objects[this] = collector::reset(derived, deallocate);
-        }
+        deallocate_payload(data, n * sizeof(T));
       }
 
-      template <typename Pointer>
-      void reset(Pointer const derived)
+      template <typename U>
+      auto operator ==(allocator<U> const&) const noexcept
       {
-        reset(derived, deallocator<typename std::pointer_traits<Pointer>::element_type>::deallocate);
+        return true;
+      }
+
+      template <typename U>
+      auto operator !=(allocator<U> const&) const noexcept
+      {
+        return false;
       }
     };
 
-  private:
-    static inline std::mutex resource;
+    void clear()
+    {
+      if (auto const lock = acquire(); lock)
+      {
+        world const stopped;
 
-    static inline std::map<pointer<object>, pointer<region>> objects;
+        finalize();
+
+        for_each_page([](auto && p)
+        {
+          p->for_each([&](auto && r)
+          {
+            if (r->assigned())
+            {
+              deallocate(p, r);
+            }
+          });
+        });
+      }
+    }
 
-    static inline std::set<pointer<region>> regions;
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  A major collection that is already in progress, incremental or being
+     *  swept lazily, is finished first, and then a full one is made anyway:
+     *  the objects that the cycle in progress marked, or allocated black, may
+     *  have become garbage since, and only a fresh marking reclaims them.
+     *
+     * ---------------------------------------------------------------------- */
+    auto collect() -> std::size_t
+    {
+      auto const before = count();
 
-    static inline std::size_t allocation;
+      if (auto const lock = acquire(); lock)
+      {
+        auto const _ = pause();
 
-    static inline std::size_t threshold;
+        world const stopped;
 
-  public:
-    explicit collector();
+        finish();
 
-    explicit collector(collector &&) = delete;
+        measure(cycle_mark_time, [this] { mark(); });
 
-    explicit collector(collector const&) = delete;
+        measure(cycle_sweep_time, [this] { sweep(); });
 
-    ~collector();
+        record(cumulative.major_collections);
 
-    collector & operator =(collector &&) = delete;
+        allocation = 0;
+      }
 
-    collector & operator =(collector const&) = delete;
+      return before - count();
+    }
 
-    auto allocate(std::size_t const size)
+    auto collect_young() -> std::size_t
     {
-      if (auto data = ::operator new(size); data)
+      auto const before = count();
+
+      if (auto const lock = acquire(); lock)
       {
-        if (overflow())
-        {
-          collect();
-        }
+        minor();
+      }
+
+      return before - count();
+    }
 
-        allocation += size;
+    auto count() -> std::size_t
+    {
+      if (auto const lock = acquire(); lock)
+      {
+        world const stopped;
 
-        regions.insert(new region(data, size));
+        finalize();
 
-        return data;
+        return size;
       }
       else
       {
-        throw std::bad_alloc();
+        return size;
       }
     }
 
-    void clear()
+    static void interrupt(int const request) noexcept
     {
-      for (auto iter = std::begin(regions); iter != std::end(regions); )
-      {
-        assert(*iter);
+      interrupts.fetch_or(request);
+    }
 
-        if (pointer<region> region = *iter; region->assigned())
-        {
-          delete region;
-          iter = regions.erase(iter);
-        }
-        else
-        {
-          ++iter;
-        }
-      }
+    auto interrupted() noexcept -> int
+    {
+      return interrupts.load(std::memory_order_relaxed) ? interrupts.exchange(0) : 0;
     }
 
-    auto collect() -> std::size_t
+    auto stats() -> statistics const&
     {
-      auto const before = count();
+      if (auto const lock = acquire(); lock)
+      {
+        world const stopped;
+      }
 
-      if (auto const lock = std::unique_lock(resource); lock)
+      return cumulative;
+    }
+
+    /* ---- Census -------------------------------------------------------------
+     *
+     *  Calls f with every object that has been assigned the deallocator of T,
+     *  while holding the lock and the world. f must not allocate.
+     *
+     * ---------------------------------------------------------------------- */
+    template <typename T, typename F>
+    void for_each_object(F&& f)
+    {
+      if (auto const lock = acquire(); lock)
       {
-        mark(), sweep();
+        world const stopped;
 
-        allocation = 0;
-      }
+        finalize();
 
-      return before - count();
+        for_each_page([&](auto && p)
+        {
+          p->for_each([&](auto && r)
+          {
+            if (r->assigned(deallocator<T>::deallocate))
+            {
+              f(static_cast<pointer<T>>(r->derived()));
+            }
+          });
+        });
+      }
     }
 
-    auto count() const noexcept -> std::size_t
+    template <typename F>
+    void for_each_region(F&& f)
     {
-      return std::size(regions);
+      if (auto const lock = acquire(); lock)
+      {
+        world const stopped;
+
+        finalize();
+
+        for_each_page([&](auto && p)
+        {
+          p->for_each(f);
+        });
+      }
     }
 
-    auto deallocate(pointer<void> const data, std::size_t const = 0)
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Calls f with the region referred to by each root, and with each object
+     *  under construction, in the order marking shades them. A region may be
+     *  passed more than once.
+     *
+     * ---------------------------------------------------------------------- */
+    template <typename F>
+    void for_each_root(F&& f)
     {
-      try
+      if (auto const lock = acquire(); lock)
       {
-        if (auto const iter = region_of(data); *iter)
+        world const stopped;
+
+        for (auto r : young)
         {
-          regions.erase(iter);
+          if (r->allocated() and not r->assigned())
+          {
+            f(r);
+          }
         }
-      }
-      catch (...)
-      {}
 
-      ::operator delete(data);
+        for_each_root_cell([&](auto && root)
+        {
+          if (auto const r = region_of(root->target()); r)
+          {
+            f(r);
+          }
+        });
+      }
     }
 
-    auto mark() -> void
+    auto deallocate(pointer<void> const data, std::size_t const = 0)
     {
-      marker::toggle();
-
-      for (auto [derived, region] : objects)
+      if (auto const lock = acquire(); lock)
       {
-        if (region and not region->marked() and region_of(derived) == std::cend(regions))
+        world const stopped;
+
+        if (auto const p = pages.find(reinterpret_cast<std::uintptr_t>(data)); p)
         {
-          traverse(region);
+          if (auto const r = p->region_of(reinterpret_cast<std::uintptr_t>(data)); r)
+          {
+            young.erase(r);
+            deallocate(p, r);
+          }
         }
       }
     }
 
+    void mark();
+
+    void mark_young();
+
     auto overflow() const noexcept -> bool
     {
       return threshold < allocation;
     }
 
-    static auto region_of(pointer<void> const interior) -> decltype(regions)::iterator
+    static void finalize_lazily(pointer<void> const derived) noexcept
     {
-      region dummy { interior, 0 };
+      if (auto const r = region_of(derived); r)
+      {
+        r->finalize_lazily();
+      }
+    }
 
-      if (auto iter = regions.lower_bound(&dummy); iter != std::cend(regions) and (**iter).contains(interior))
+    static auto region_of(pointer<void> const interior) noexcept -> pointer<region>
+    {
+      if (tag_of(interior))
+      {
+        return nullptr; // immediate value
+      }
+      else if (auto const p = pages.find(reinterpret_cast<std::uintptr_t>(interior)); p)
       {
-        return iter;
+        return p->region_of(reinterpret_cast<std::uintptr_t>(interior));
       }
       else
       {
-        return std::cend(regions);
+        return nullptr;
       }
     }
 
     static auto reset(pointer<void> const derived, deallocator<void>::signature const deallocate) -> pointer<region>
     {
-      if (auto const lock = std::unique_lock(resource); lock and derived)
+      if (derived and not tag_of(derived))
       {
-        auto const iter = region_of(derived);
+        auto const region = region_of(derived);
 
-        assert(iter != std::cend(regions));
+        assert(region);
         assert(deallocate);
 
-        return (*iter)->reset(derived, deallocate);
+        return region->reset(derived, deallocate);
       }
       else
       {
@@ -219,50 +1224,337 @@ inline namespace memory
       }
     }
 
+    auto mark_threads() const noexcept
+    {
+      return threads;
+    }
+
+    void reset_mark_threads(std::size_t const n = std::thread::hardware_concurrency())
+    {
+      if (auto const lock = acquire(); lock)
+      {
+        threads = std::max<std::size_t>(n, 1);
+      }
+    }
+
+    auto mark_stack_limit() const noexcept
+    {
+      return gray_limit;
+    }
+
+    void reset_mark_stack_limit(std::size_t const n = mark_stack_limit_default)
+    {
+      if (auto const lock = acquire(); lock)
+      {
+        gray_limit = std::max<std::size_t>(n, 1);
+      }
+    }
+
+    auto pause_budget() const noexcept
+    {
+      return budget;
+    }
+
+    auto collecting() const noexcept
+    {
+      return state != cycle::idle;
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Returns a number that changes whenever regions are freed, by a sweep or
+     *  by reclaiming an arena. While it stays the same, no address has been
+     *  reused by another object, so an address that is not kept alive (see
+     *  code::cache) may be compared as long as the free epoch it was taken in
+     *  is compared too. It is only changed under the lock, and read without.
+     *
+     * ---------------------------------------------------------------------- */
+    static auto free_epoch() noexcept
+    {
+      return frees.load(std::memory_order_relaxed);
+    }
+
+    void reset_pause_budget(std::chrono::microseconds const microseconds = std::chrono::microseconds(0))
+    {
+      if (auto const lock = acquire(); lock)
+      {
+        budget = microseconds;
+      }
+    }
+
     void reset_threshold(std::size_t const size = std::numeric_limits<std::size_t>::max())
     {
-      if (auto const lock = std::unique_lock(resource); lock)
+      if (auto const lock = acquire(); lock)
       {
         threshold = size;
       }
     }
 
-    void sweep()
+    auto heap_growth() const noexcept
+    {
+      return growth;
+    }
+
+    void reset_heap_growth(double const factor = 2)
+    {
+      if (auto const lock = acquire(); lock)
+      {
+        growth = std::max(factor, 1.0);
+      }
+    }
+
+    auto heap_limit() const noexcept
+    {
+      return limit;
+    }
+
+    void reset_heap_limit(std::size_t const size = std::numeric_limits<std::size_t>::max())
+    {
+      if (auto const lock = acquire(); lock)
+      {
+        limit = size;
+        overdrawn = false;
+      }
+    }
+
+    auto max_threshold() const noexcept
+    {
+      return threshold_max;
+    }
+
+    void reset_max_threshold(std::size_t const size = 1_GiB)
+    {
+      if (auto const lock = acquire(); lock)
+      {
+        threshold_max = size;
+      }
+    }
+
+    auto min_threshold() const noexcept
+    {
+      return threshold_min;
+    }
+
+    void reset_min_threshold(std::size_t const size = 16_MiB)
+    {
+      if (auto const lock = acquire(); lock)
+      {
+        threshold_min = size;
+      }
+    }
+
+    void sweep();
+
+    void sweep_young();
+
+    template <typename F>
+    static void trace(pointer<region> const the_region, F&& f)
+    {
+      pages.find(reinterpret_cast<std::uintptr_t>(the_region))->for_each_cell(the_region, [&](auto && address)
+      {
+        f(region_of(object::at(address)->target()));
+      });
+    }
+
+
+  private:
+    /* ---- Heap Reservation ---------------------------------------------------
+     *
+     *  With compressed references, a cell refers to an object by its offset
+     *  from heap_base (see meevax/memory/tagged_pointer.hpp), so every page
+     *  must lie within 4 GiB of it. The first page reserves that much address
+     *  space, inaccessible and without backing memory, and pages are carved
+     *  out of it from the bottom up. A freed page is returned to the system
+     *  with madvise and its extent is kept as a hole to be carved again; the
+     *  heap cannot grow beyond the reservation.
+     *
+     *  Holes are kept by address, so that a freed page merges with the holes
+     *  on either side of it, and a hole that reaches the top of the carved
+     *  space is given back to the bump pointer. Otherwise pages of different
+     *  sizes would leave the reservation split into holes too small for any
+     *  request while most of it is free. A page is carved from the smallest
+     *  hole that fits, found through the same holes by size.
+     *
+     * ---------------------------------------------------------------------- */
+    #ifdef MEEVAX_COMPRESSED_REFERENCES
+    static constexpr std::size_t reservation_size = 4_GiB;
+
+    static inline std::size_t reserved; // bytes carved out of the reservation so far
+
+    static inline std::map<std::uintptr_t, std::size_t> holes; // extents of freed pages, by address
+
+    static inline std::set<std::pair<std::size_t, std::uintptr_t>> fits; // the same extents, by size
+    #endif
+
+    static auto allocate_page(std::size_t const, std::size_t const) -> pointer<page>;
+
+    static auto acquire_page(std::size_t const k) -> pointer<page>
     {
-      for (auto iter = std::begin(regions); iter != std::end(regions); )
+      if (current)
       {
-        assert(*iter);
+        return acquire_empty_page(k);
+      }
 
-        if (pointer<region> region = *iter; not region->marked())
+      for (auto p = cursor[k]; p; p = cursor[k] = p->next)
+      {
+        if (not p->owned and not p->full())
         {
-          if (region->assigned())
-          {
-            delete region;
-            iter = regions.erase(iter);
-            continue;
-          }
-          else
-          {
-            region->mark();
-          }
+          return p;
+        }
+      }
+
+      /* ---- NOTE -------------------------------------------------------------
+       *
+       *  Every page behind the cursor is full or owned by a buffer until the
+       *  next sweep, so a new page is appended to the tail of the list and the
+       *  cursor never scans the same page twice.
+       *
+       * -------------------------------------------------------------------- */
+      auto const p = allocate_page(size_classes[k], page::capacity_of(size_classes[k]));
+
+      (tail[k] ? tail[k]->next : heap[k]) = p;
+      tail[k] = cursor[k] = p;
+
+      return p;
+    }
+
+    static auto acquire_empty_page(std::size_t const) -> pointer<page>;
+
+    static void adopt(std::size_t const, pointer<page> const); // into the current arena
+
+    static void reclaim(arena &);
+
+    static auto allocate_region(std::size_t const size) -> pointer<region>
+    {
+      if (auto const k = size_class_of(size); k < large)
+      {
+        return acquire_page(k)->allocate(size);
+      }
+      else
+      {
+        auto const p = allocate_page(sizeof(region) + (size + 15) / 16 * 16, 1);
+
+        p->next = heap[large];
+        heap[large] = p;
+
+        if (current)
+        {
+          adopt(large, p);
         }
 
-        ++iter;
+        return p->allocate(size);
+      }
+    }
+
+    static void deallocate(pointer<page> const p, pointer<region> const r)
+    {
+      frees.store(frees.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      occupancy -= r->bytes();
+      p->deallocate(r);
+      --size;
+    }
+
+    static void deallocate_page(pointer<page> const p);
+
+    static auto finalize(std::size_t = std::numeric_limits<std::size_t>::max()) -> bool;
+
+    void major();
+
+    void minor();
+
+    static void release_empty_large_pages();
+
+    static auto attach() -> pointer<buffer>;
+
+    static void detach();
+
+    static void flush(buffer &);
+
+    auto refill(std::size_t const) -> pointer<void>;
+
+    void make_room(std::size_t const);
+
+    static void retire(buffer &);
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Outside a world, the barrier runs concurrently with the barriers of
+     *  other threads, so it claims a region by an atomic exchange of its mark
+     *  and records it in the buffer of the thread.
+     *
+     * ---------------------------------------------------------------------- */
+    static void barrier(pointer<page> const p, pointer<object const> const x)
+    {
+      if (state == cycle::marking)
+      {
+        shade_concurrently(region_of(x->target()));
+      }
+
+      if (auto const r = p->region_of(reinterpret_cast<std::uintptr_t>(x)); r and (not r->young() or state == cycle::sweeping) and r->remember())
+      {
+        record(&buffer::remembered, remembered, r);
       }
     }
 
-    void traverse(pointer<region> const the_region)
+    static void shade_concurrently(pointer<region> const);
+
+    static void record(std::vector<pointer<region>> buffer::* const, registry<pointer<region>> &, pointer<region> const);
+
+    static auto drain(std::chrono::steady_clock::time_point const) -> bool;
+
+    static void finish();
+
+    static void mark_in_parallel();
+
+    static void prepare_sweep();
+
+    static void remark();
+
+    static void rescan();
+
+    static void rescan_young();
+
+    static void shade(pointer<region> const the_region)
     {
       if (the_region and not the_region->marked())
       {
         the_region->mark();
+        push_gray(the_region);
+      }
+    }
+
+    static void push_gray(pointer<region> const the_region)
+    {
+      if (std::size(gray) < gray_limit)
+      {
+        gray.push_back(the_region);
+      }
+      else if (not std::exchange(overflowed, true))
+      {
+        ++cumulative.mark_stack_overflows;
+      }
+    }
+
+    static void settle(void (*)());
+
+    static void shade_roots();
+
+    static void start();
 
-        auto lower = objects.lower_bound(reinterpret_cast<pointer<object>>(the_region->lower_bound()));
-        auto upper = objects.lower_bound(reinterpret_cast<pointer<object>>(the_region->upper_bound()));
+    static void step();
 
-        for (auto iter = lower; iter != upper; ++iter)
+    static auto sweep(std::chrono::steady_clock::time_point const, std::size_t = std::numeric_limits<std::size_t>::max()) -> bool;
+
+    static void sweep(pointer<page> const);
+
+    template <typename F>
+    static void for_each_page(F&& f)
+    {
+      for (auto const& list : heap)
+      {
+        for (auto p = list; p; p = p->next)
         {
-          traverse(iter->second);
+          f(p);
         }
       }
     }
@@ -1,12 +1,21 @@
 #ifndef INCLUDED_MEEVAX_MEMORY_DEALLOCATOR_HPP
 #define INCLUDED_MEEVAX_MEMORY_DEALLOCATOR_HPP
 
+#include <memory> // std::destroy_at
+
 #include <meevax/memory/pointer.hpp>
 
 namespace meevax
 {
 inline namespace memory
 {
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  The deallocator only finalizes the object. The storage belongs to the
+   *  page the object was allocated from, and is returned to it by the
+   *  collector after the destructor has run.
+   *
+   * ------------------------------------------------------------------------ */
   template <typename T>
   struct deallocator
   {
@@ -14,7 +23,7 @@ inline namespace memory
 
     static void deallocate(pointer<void> const p)
     {
-      delete static_cast<const pointer<const T>>(p);
+      std::destroy_at(static_cast<const pointer<T>>(p));
     }
   };
 } // namespace memory
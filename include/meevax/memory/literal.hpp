@@ -14,6 +14,11 @@ inline namespace memory
   {
     return size * 1024 * 1024;
   }
+
+  constexpr auto operator ""_GiB(unsigned long long size)
+  {
+    return size * 1024 * 1024 * 1024;
+  }
 } // namespace memory
 } // namespace meevax
 
@@ -1,15 +1,24 @@
 #ifndef INCLUDED_MEEVAX_MEMORY_MARKER_HPP
 #define INCLUDED_MEEVAX_MEMORY_MARKER_HPP
 
+#include <atomic>
+
 namespace meevax
 {
 inline namespace memory
 {
+  /* ---- NOTE -----------------------------------------------------------------
+   *
+   *  The value is atomic so that parallel markers can claim a region with
+   *  try_mark. Every other access is relaxed, which compiles to a plain load
+   *  or store.
+   *
+   * ------------------------------------------------------------------------ */
   class marker
   {
     static inline bool phase;
 
-    bool value;
+    std::atomic<bool> value;
 
   public:
     struct initializer
@@ -23,17 +32,24 @@ inline namespace memory
 
     auto mark() noexcept
     {
-      return value = phase;
+      value.store(phase, std::memory_order_relaxed);
+      return phase;
     }
 
     auto unmark() noexcept
     {
-      return value = not phase;
+      value.store(not phase, std::memory_order_relaxed);
+      return not phase;
     }
 
     auto marked() const noexcept
     {
-      return value == phase;
+      return value.load(std::memory_order_relaxed) == phase;
+    }
+
+    auto try_mark() noexcept
+    {
+      return value.exchange(phase, std::memory_order_relaxed) != phase;
     }
 
     static auto toggle() noexcept
@@ -0,0 +1,319 @@
+#ifndef INCLUDED_MEEVAX_MEMORY_PAGE_HPP
+#define INCLUDED_MEEVAX_MEMORY_PAGE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib> // std::aligned_alloc, std::free
+
+#include <meevax/memory/literal.hpp>
+#include <meevax/memory/region.hpp>
+
+namespace meevax
+{
+inline namespace memory
+{
+  /* ---- Page -----------------------------------------------------------------
+   *
+   *  A page is a page_size aligned chunk of memory divided into slots of the
+   *  same size. Each slot is a region header followed by the storage of an
+   *  object. Because pages are aligned to their own size, the page that an
+   *  address belongs to is found by masking the address, and the slot is
+   *  found by dividing the offset from the first slot by the slot size.
+   *
+   *  Objects too large for any size class get a page of their own, spanning
+   *  as many page_size units as needed (large object space).
+   *
+   *  The page header is followed by a bitmap with one bit for each word of
+   *  the page. A bit is set while a cell lives at that word, so the cells
+   *  inside an object are found by scanning the bits of its address range
+   *  instead of searching a global table.
+   *
+   * ------------------------------------------------------------------------ */
+  constexpr std::size_t page_shift = 16;
+
+  constexpr std::size_t page_size = 64_KiB;
+
+  static_assert(page_size == (std::size_t(1) << page_shift));
+
+  /* ---- Size Classes ---------------------------------------------------------
+   *
+   *  Slot sizes including the 16 byte region header. The smallest class is
+   *  sized for pairs, and object sizes grow by 16 bytes up to 256 bytes, then
+   *  by coarser steps up to 2 KiB. Anything larger goes to the large object
+   *  space.
+   *
+   * ------------------------------------------------------------------------ */
+  constexpr std::array<std::size_t, 24> size_classes
+  {
+      32,   48,   64,   80,   96,  112,  128,  144,
+     160,  176,  192,  208,  224,  240,  256,  272,
+     336,  400,  528,  656,  784, 1040, 1552, 2064,
+  };
+
+  constexpr auto large = std::size(size_classes);
+
+  constexpr auto size_class_table = []() constexpr
+  {
+    std::array<std::uint8_t, (size_classes.back() - sizeof(region)) / 16 + 1> table {};
+
+    for (std::size_t i = 0, k = 0; i < std::size(table); ++i)
+    {
+      while (size_classes[k] - sizeof(region) < i * 16)
+      {
+        ++k;
+      }
+
+      table[i] = k;
+    }
+
+    return table;
+  }();
+
+  constexpr auto size_class_of(std::size_t const size) noexcept -> std::size_t
+  {
+    if (auto const index = (size + 15) / 16; index < std::size(size_class_table))
+    {
+      return size_class_table[index];
+    }
+    else
+    {
+      return large;
+    }
+  }
+
+  class page
+  {
+    std::size_t const slot_size;
+
+    std::size_t const capacity;
+
+    std::size_t const header; // size of this header and the cell bitmap
+
+    std::size_t bump = 0; // number of slots ever handed out
+
+    pointer<region> free = nullptr; // released slots, linked through their storage
+
+  public:
+    pointer<page> next = nullptr;
+
+    std::size_t live = 0; // number of allocated slots
+
+    bool owned = false; // allocated from by the buffer of one thread only
+
+    explicit page(std::size_t const slot_size, std::size_t const capacity) noexcept
+      : slot_size { slot_size }
+      , capacity { capacity }
+      , header { header_size(extent_of(slot_size, capacity)) }
+    {
+      std::fill_n(cells(), (header - sizeof(page)) / sizeof(std::uint64_t), 0);
+    }
+
+    static constexpr auto header_size(std::size_t const extent) noexcept -> std::size_t
+    {
+      return (sizeof(page) + extent / sizeof(std::uintptr_t) / 8 + 15) / 16 * 16;
+    }
+
+    static constexpr auto capacity_of(std::size_t const slot_size) noexcept -> std::size_t
+    {
+      return std::max<std::size_t>((page_size - header_size(page_size)) / slot_size, 1);
+    }
+
+    static constexpr auto extent_of(std::size_t const slot_size, std::size_t const capacity) noexcept -> std::size_t
+    {
+      auto extent = (sizeof(page) + slot_size * capacity + page_size - 1) / page_size * page_size;
+
+      while (extent < header_size(extent) + slot_size * capacity)
+      {
+        extent += page_size;
+      }
+
+      return extent;
+    }
+
+    auto extent() const noexcept
+    {
+      return extent_of(slot_size, capacity);
+    }
+
+    auto lower_bound() const noexcept
+    {
+      return reinterpret_cast<std::uintptr_t>(this) + header;
+    }
+
+    auto upper_bound() const noexcept
+    {
+      return lower_bound() + slot_size * capacity;
+    }
+
+    auto contains(std::uintptr_t const k) const noexcept
+    {
+      return lower_bound() <= k and k < upper_bound();
+    }
+
+    auto full() const noexcept
+    {
+      return not free and capacity <= bump;
+    }
+
+    auto empty() const noexcept
+    {
+      return not live;
+    }
+
+    auto slot(std::size_t const index) const noexcept
+    {
+      return reinterpret_cast<pointer<region>>(lower_bound() + slot_size * index);
+    }
+
+    auto region_of(std::uintptr_t const interior) const noexcept -> pointer<region>
+    {
+      if (auto const index = (interior - lower_bound()) / slot_size; contains(interior) and index < bump)
+      {
+        if (auto const r = slot(index); r->allocated() and r->contains(interior))
+        {
+          return r;
+        }
+      }
+
+      return nullptr;
+    }
+
+    auto allocate(std::size_t const size) noexcept -> pointer<region>
+    {
+      assert(size + sizeof(region) <= slot_size);
+
+      if (free)
+      {
+        auto const r = free;
+        free = *reinterpret_cast<pointer<pointer<region>>>(r->lower_bound());
+        ++live;
+        return new (r) region(size);
+      }
+      else if (bump < capacity)
+      {
+        ++live;
+        return new (slot(bump++)) region(size);
+      }
+      else
+      {
+        return nullptr;
+      }
+    }
+
+    void deallocate(pointer<region> const r) noexcept
+    {
+      assert(r->allocated());
+
+      r->release();
+
+      *reinterpret_cast<pointer<pointer<region>>>(r->lower_bound()) = free;
+      free = r;
+      --live;
+    }
+
+    void reset() noexcept
+    {
+      std::fill_n(cells(), (header - sizeof(page)) / sizeof(std::uint64_t), 0);
+      bump = 0;
+      free = nullptr;
+      live = 0;
+    }
+
+    auto cells() noexcept -> pointer<std::uint64_t>
+    {
+      return reinterpret_cast<pointer<std::uint64_t>>(this + 1);
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Threads that create cells in objects of the same page set bits of the
+     *  same words, so once a second thread has allocated, bits are set and
+     *  cleared by atomic operations. Until then a single thread creates every
+     *  cell in the heap, and the plain operations save a locked instruction
+     *  per cell.
+     *
+     *  The collector sets shared when it attaches the second thread, under a
+     *  world: the thread that was running alone is stopped at a safepoint, so
+     *  it is not between reading shared and setting a bit with a plain
+     *  operation, and the locks of the world make it see shared set when it
+     *  resumes. Before that, the second thread has no page to create cells
+     *  in.
+     *
+     * ---------------------------------------------------------------------- */
+    static inline std::atomic<bool> shared = false;
+
+    void insert(std::uintptr_t const cell) noexcept
+    {
+      auto const index = (cell - reinterpret_cast<std::uintptr_t>(this)) / sizeof(std::uintptr_t);
+
+      if (shared.load(std::memory_order_relaxed))
+      {
+        __atomic_fetch_or(cells() + index / 64, std::uint64_t(1) << (index % 64), __ATOMIC_RELAXED);
+      }
+      else
+      {
+        cells()[index / 64] |= std::uint64_t(1) << (index % 64);
+      }
+    }
+
+    void erase(std::uintptr_t const cell) noexcept
+    {
+      auto const index = (cell - reinterpret_cast<std::uintptr_t>(this)) / sizeof(std::uintptr_t);
+
+      if (shared.load(std::memory_order_relaxed))
+      {
+        __atomic_fetch_and(cells() + index / 64, ~(std::uint64_t(1) << (index % 64)), __ATOMIC_RELAXED);
+      }
+      else
+      {
+        cells()[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+      }
+    }
+
+    template <typename F>
+    void for_each_cell(pointer<region> const r, F&& f) noexcept
+    {
+      auto const base = reinterpret_cast<std::uintptr_t>(this);
+
+      auto const lower = (r->lower_bound() - base) / sizeof(std::uintptr_t);
+      auto const upper = (r->upper_bound() - base + sizeof(std::uintptr_t) - 1) / sizeof(std::uintptr_t);
+
+      for (auto index = lower; index < upper; )
+      {
+        if (auto const bits = cells()[index / 64] >> (index % 64); bits)
+        {
+          index += __builtin_ctzll(bits);
+
+          if (index < upper)
+          {
+            f(base + index * sizeof(std::uintptr_t));
+          }
+
+          ++index;
+        }
+        else
+        {
+          index = (index / 64 + 1) * 64;
+        }
+      }
+    }
+
+    template <typename F>
+    void for_each(F&& f) const
+    {
+      for (std::size_t index = 0; index < bump; ++index)
+      {
+        if (auto const r = slot(index); r->allocated())
+        {
+          f(r);
+        }
+      }
+    }
+  };
+} // namespace memory
+} // namespace meevax
+
+#endif // INCLUDED_MEEVAX_MEMORY_PAGE_HPP
@@ -0,0 +1,105 @@
+#ifndef INCLUDED_MEEVAX_MEMORY_PAGE_TABLE_HPP
+#define INCLUDED_MEEVAX_MEMORY_PAGE_TABLE_HPP
+
+#include <meevax/memory/page.hpp>
+
+namespace meevax
+{
+inline namespace memory
+{
+  /* ---- Page Table -----------------------------------------------------------
+   *
+   *  Two level radix table from page numbers to pages. A page number is an
+   *  address shifted right by page_shift, so on a 48 bit address space it is
+   *  32 bits wide and split into a 16 bit directory index and a 16 bit leaf
+   *  index. Leaves are allocated on first use, so the table costs one
+   *  directory (512 KiB of zero-initialized memory) plus one leaf per 4 GiB of
+   *  address space actually used by the heap.
+   *
+   *  A large object spans several page numbers, and each of them maps to the
+   *  head of the large page.
+   *
+   *  The table is only modified under the lock of the collector, but is read
+   *  by every thread that creates a cell, so entries are published with
+   *  release stores and read with acquire loads.
+   *
+   * ------------------------------------------------------------------------ */
+  class page_table
+  {
+    static constexpr std::size_t address_width = 48;
+
+    static constexpr std::size_t leaf_width = (address_width - page_shift) / 2;
+
+    using leaf = std::array<pointer<page>, std::size_t(1) << leaf_width>;
+
+    std::array<pointer<leaf>, std::size_t(1) << (address_width - page_shift - leaf_width)> directory {};
+
+    static constexpr auto directory_index(std::uintptr_t const address) noexcept
+    {
+      return (address >> page_shift) >> leaf_width;
+    }
+
+    static constexpr auto leaf_index(std::uintptr_t const address) noexcept
+    {
+      return (address >> page_shift) & ((std::size_t(1) << leaf_width) - 1);
+    }
+
+  public:
+    auto find(std::uintptr_t const address) const noexcept -> pointer<page>
+    {
+      if (address >> address_width)
+      {
+        return nullptr;
+      }
+      else if (auto const l = __atomic_load_n(&directory[directory_index(address)], __ATOMIC_ACQUIRE); l)
+      {
+        return __atomic_load_n(&(*l)[leaf_index(address)], __ATOMIC_ACQUIRE);
+      }
+      else
+      {
+        return nullptr;
+      }
+    }
+
+    void assign(pointer<page> const p, pointer<page> const value)
+    {
+      auto const lower = reinterpret_cast<std::uintptr_t>(p);
+
+      for (auto address = lower; address < lower + p->extent(); address += page_size)
+      {
+        assert(not (address >> address_width));
+
+        auto & l = directory[directory_index(address)];
+
+        if (not l)
+        {
+          __atomic_store_n(&l, new leaf {}, __ATOMIC_RELEASE);
+        }
+
+        __atomic_store_n(&(*l)[leaf_index(address)], value, __ATOMIC_RELEASE);
+      }
+    }
+
+    void insert(pointer<page> const p)
+    {
+      assign(p, p);
+    }
+
+    void erase(pointer<page> const p)
+    {
+      assign(p, nullptr);
+    }
+
+    void clear()
+    {
+      for (auto & l : directory)
+      {
+        delete l;
+        l = nullptr;
+      }
+    }
+  };
+} // namespace memory
+} // namespace meevax
+
+#endif // INCLUDED_MEEVAX_MEMORY_PAGE_TABLE_HPP
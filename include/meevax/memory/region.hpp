@@ -2,7 +2,6 @@
 #define INCLUDED_MEEVAX_MEMORY_REGION_HPP
 
 #include <cstdint> // std::uintptr_t
-#include <functional> // std::less
 #include <new>
 #include <type_traits>
 
@@ -14,18 +13,38 @@ namespace meevax
 {
 inline namespace memory
 {
+  /* ---- Region ---------------------------------------------------------------
+   *
+   *  Region is the header placed in front of every object allocated by the
+   *  collector. The storage of the object immediately follows the header, so
+   *  the header itself does not know its own address range except through its
+   *  own address.
+   *
+   *  The layout is packed into two words: the marker, the generation flags
+   *  and the offset of the derived pointer share the first word with the size
+   *  of the object, and the second word holds the deallocator.
+   *
+   * ------------------------------------------------------------------------ */
   class region : public marker
   {
-    pointer<void> base, derived = nullptr;
+    std::uint8_t old : 1; // survived a collection
 
-    std::size_t size;
+    std::uint8_t remembered : 1; // old, and stored to since the last collection
+
+    std::uint8_t deferred : 1; // finalized from the finalization queue
+
+    std::uint16_t offset = 0;
+
+    std::uint32_t size;
 
     deallocator<void>::signature deallocate = nullptr;
 
   public:
-    explicit region(pointer<void> const base, std::size_t const size)
-      : base { base }
-      , size { size }
+    explicit region(std::size_t const size) noexcept
+      : old { false }
+      , remembered { false }
+      , deferred { false }
+      , size { static_cast<std::uint32_t>(size) }
     {}
 
     ~region()
@@ -35,7 +54,7 @@ inline namespace memory
 
     auto lower_bound() const noexcept
     {
-      return reinterpret_cast<std::uintptr_t>(base);
+      return reinterpret_cast<std::uintptr_t>(this + 1);
     }
 
     auto upper_bound() const noexcept
@@ -53,16 +72,74 @@ inline namespace memory
       return contains(reinterpret_cast<std::uintptr_t>(derived));
     }
 
+    auto allocated() const noexcept
+    {
+      return 0 < size;
+    }
+
     auto assigned() const noexcept
     {
-      return derived and deallocate;
+      return deallocate != nullptr;
+    }
+
+    auto assigned(deallocator<void>::signature const f) const noexcept
+    {
+      return deallocate == f;
+    }
+
+    auto young() const noexcept
+    {
+      return not old;
+    }
+
+    void promote() noexcept
+    {
+      old = true;
+    }
+
+    auto remember() noexcept
+    {
+      if (remembered)
+      {
+        return false;
+      }
+      else
+      {
+        remembered = true;
+        return true;
+      }
+    }
+
+    void forget() noexcept
+    {
+      remembered = false;
+    }
+
+    auto finalized_lazily() const noexcept
+    {
+      return deferred;
+    }
+
+    void finalize_lazily() noexcept
+    {
+      deferred = true;
+    }
+
+    auto bytes() const noexcept -> std::size_t
+    {
+      return size;
+    }
+
+    auto derived() const noexcept
+    {
+      return reinterpret_cast<pointer<void>>(lower_bound() + offset);
     }
 
     auto reset(pointer<void> const x, deallocator<void>::signature const f) noexcept
     {
-      if (not assigned())
+      if (not assigned() and contains(x))
       {
-        derived = x;
+        offset = reinterpret_cast<std::uintptr_t>(x) - lower_bound();
         deallocate = f;
       }
 
@@ -73,28 +150,21 @@ inline namespace memory
     {
       if (assigned())
       {
-        deallocate(derived);
+        deallocate(derived());
       }
 
-      reset(nullptr, nullptr);
+      old = false;
+      remembered = false;
+      deferred = false;
+      offset = 0;
+      deallocate = nullptr;
 
       size = 0;
     }
   };
+
+  static_assert(sizeof(region) == 16);
 } // namespace memory
 } // namespace meevax
 
-namespace std
-{
-  template <>
-  struct less<meevax::pointer<meevax::region>>
-  {
-    bool operator ()(meevax::const_pointer<meevax::region> x,
-                     meevax::const_pointer<meevax::region> y) const
-    {
-      return (*x).upper_bound() <= (*y).lower_bound();
-    }
-  };
-} // namespace std
-
 #endif // INCLUDED_MEEVAX_MEMORY_REGION_HPP
@@ -0,0 +1,128 @@
+#ifndef INCLUDED_MEEVAX_MEMORY_REGISTRY_HPP
+#define INCLUDED_MEEVAX_MEMORY_REGISTRY_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib> // std::realloc
+#include <new>
+#include <type_traits>
+
+#include <meevax/memory/pointer.hpp>
+
+namespace meevax
+{
+inline namespace memory
+{
+  /* ---- Registry -------------------------------------------------------------
+   *
+   *  Growable array of trivially copyable values used for the bookkeeping of
+   *  the collector. Unlike std::vector, it is a literal type that is
+   *  constant-initialized, because cells in static storage may allocate and
+   *  register themselves before any dynamic initialization has run. For the
+   *  same reason, its storage is never freed.
+   *
+   * ------------------------------------------------------------------------ */
+  template <typename T>
+  class registry
+  {
+    static_assert(std::is_trivially_copyable<T>::value);
+
+    pointer<T> data;
+
+    std::size_t length;
+
+    std::size_t capacity;
+
+  public:
+    constexpr registry() noexcept
+      : data { nullptr }
+      , length { 0 }
+      , capacity { 0 }
+    {}
+
+    auto begin() const noexcept
+    {
+      return data;
+    }
+
+    auto end() const noexcept
+    {
+      return data + length;
+    }
+
+    auto size() const noexcept
+    {
+      return length;
+    }
+
+    auto empty() const noexcept
+    {
+      return not length;
+    }
+
+    auto operator [](std::size_t const index) const noexcept -> T &
+    {
+      assert(index < length);
+      return data[index];
+    }
+
+    auto back() const noexcept -> T &
+    {
+      assert(length);
+      return data[length - 1];
+    }
+
+    auto push_back(T const& x) -> std::size_t
+    {
+      if (capacity <= length)
+      {
+        capacity = std::max<std::size_t>(capacity * 2, 1024);
+
+        if (auto const p = std::realloc(data, sizeof(T) * capacity); p)
+        {
+          data = static_cast<pointer<T>>(p);
+        }
+        else
+        {
+          throw std::bad_alloc();
+        }
+      }
+
+      data[length] = x;
+
+      return length++;
+    }
+
+    void pop_back() noexcept
+    {
+      assert(length);
+      --length;
+    }
+
+    void erase(T const& x) noexcept
+    {
+      for (auto index = length; 0 < index--; )
+      {
+        if (data[index] == x)
+        {
+          data[index] = data[--length];
+          return;
+        }
+      }
+    }
+
+    void clear() noexcept
+    {
+      length = 0;
+    }
+
+    template <typename Predicate>
+    void remove_if(Predicate&& satisfy)
+    {
+      length = std::remove_if(begin(), end(), std::forward<decltype(satisfy)>(satisfy)) - begin();
+    }
+  };
+} // namespace memory
+} // namespace meevax
+
+#endif // INCLUDED_MEEVAX_MEMORY_REGISTRY_HPP
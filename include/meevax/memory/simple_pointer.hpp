@@ -7,6 +7,8 @@
 #include <type_traits>
 #include <utility>
 
+#include <meevax/memory/tagged_pointer.hpp>
+
 namespace meevax
 {
 inline namespace memory
@@ -24,15 +26,39 @@ inline namespace memory
 
     using const_pointer = typename std::add_const<pointer>::type;
 
+    #ifdef MEEVAX_COMPRESSED_REFERENCES
+    compressed_word data;
+
+    static constexpr auto encode(pointer const p) noexcept
+    {
+      return compress(reinterpret_cast<word>(p));
+    }
+
+    static constexpr auto decode(compressed_word const c) noexcept
+    {
+      return reinterpret_cast<pointer>(decompress(c));
+    }
+    #else
     pointer data;
 
+    static constexpr auto encode(pointer const p) noexcept
+    {
+      return p;
+    }
+
+    static constexpr auto decode(pointer const p) noexcept
+    {
+      return p;
+    }
+    #endif
+
     template <typename Pointer = pointer>
     constexpr simple_pointer(typename std::pointer_traits<Pointer>::pointer data = nullptr)
-      : data { static_cast<pointer>(data) }
+      : data { encode(static_cast<pointer>(data)) }
     {}
 
     constexpr simple_pointer(simple_pointer const& sp)
-      : data { sp.get() }
+      : data { sp.data }
     {}
 
     template <typename... Ts>
@@ -53,28 +79,29 @@ inline namespace memory
 
     explicit constexpr operator bool() const noexcept
     {
-      return data != nullptr;
+      return static_cast<bool>(data);
     }
 
     constexpr auto get() const noexcept -> pointer
     {
-      return data;
+      return decode(data);
     }
 
     constexpr auto load() const noexcept -> reference
     {
       assert(data);
-      return *data;
+      return *get();
     }
 
     auto reset(pointer const p = nullptr) noexcept -> pointer
     {
-      return data = p;
+      data = encode(p);
+      return p;
     }
 
     auto store(simple_pointer const& x) noexcept -> auto &
     {
-      data = x.get();
+      data = x.data;
       return *this;
     }
   };
@@ -0,0 +1,154 @@
+#ifndef INCLUDED_MEEVAX_MEMORY_SNAPSHOT_HPP
+#define INCLUDED_MEEVAX_MEMORY_SNAPSHOT_HPP
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <meevax/memory/collector.hpp>
+
+namespace meevax
+{
+inline namespace memory
+{
+  /* ---- Heap Snapshot --------------------------------------------------------
+   *
+   *  A snapshot is a copy of the object graph of the heap: the type, size and
+   *  outgoing references of every allocated region, and the regions referred
+   *  to by the roots. Objects are numbered from 0 in the order they are found,
+   *  and types are numbered in the same way by their names.
+   *
+   *  A snapshot is written as a single JSON object:
+   *
+   *    {
+   *      "format": "meevax-heap-snapshot",
+   *      "version": 1,
+   *      "types": [<name>, ...],
+   *      "objects": [[<type>, <size>, [<object>, ...]], ...],
+   *      "roots": [<object>, ...]
+   *    }
+   *
+   *  where <type> is an index into "types", <size> is the number of bytes of
+   *  the object excluding the region header, and <object> is an index into
+   *  "objects". A region that has not been assigned a deallocator yet (an
+   *  object under construction) is a root.
+   *
+   * ------------------------------------------------------------------------ */
+  struct snapshot
+  {
+    struct object
+    {
+      std::size_t type;
+
+      std::size_t size;
+
+      std::vector<std::size_t> edges;
+    };
+
+    std::vector<std::string> types;
+
+    std::vector<object> objects;
+
+    std::vector<std::size_t> roots;
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  The name of the type of a region is given by name_of, since only the
+     *  kernel knows what the objects are. It must not allocate from the
+     *  collector.
+     *
+     * ---------------------------------------------------------------------- */
+    template <typename F>
+    static auto take(F&& name_of) -> snapshot
+    {
+      snapshot result;
+
+      std::unordered_map<pointer<region>, std::size_t> ids;
+
+      std::unordered_map<std::string, std::size_t> type_ids;
+
+      gc.for_each_region([&](auto && r)
+      {
+        auto const name = name_of(r);
+
+        auto const [iter, inserted] = type_ids.emplace(name, std::size(result.types));
+
+        if (inserted)
+        {
+          result.types.push_back(name);
+        }
+
+        ids.emplace(r, std::size(result.objects));
+
+        result.objects.push_back({ iter->second, r->bytes(), {} });
+      });
+
+      for (auto const& [r, id] : ids)
+      {
+        collector::trace(r, [&, id = id](auto && child)
+        {
+          if (auto const iter = ids.find(child); iter != std::end(ids))
+          {
+            result.objects[id].edges.push_back(iter->second);
+          }
+        });
+      }
+
+      gc.for_each_root([&](auto && r)
+      {
+        if (auto const iter = ids.find(r); iter != std::end(ids))
+        {
+          result.roots.push_back(iter->second);
+        }
+      });
+
+      return result;
+    }
+
+    static auto read(std::istream &) -> snapshot;
+
+    auto write(std::ostream &) const -> std::ostream &;
+
+    /* ---- Dominators ---------------------------------------------------------
+     *
+     *  An object d dominates an object x if every path from the roots to x
+     *  passes through d, so that x is released when d is. The immediate
+     *  dominator of each object is computed by the iterative algorithm of
+     *  Cooper, Harvey and Kennedy over a virtual root whose children are the
+     *  roots, and is std::size(objects) for objects dominated by no other
+     *  object. Objects unreachable from the roots have no dominator, and get
+     *  std::size(objects) + 1.
+     *
+     *  The retained size of an object is the sum of the sizes of the objects
+     *  it dominates, including itself: the bytes that would be freed if it
+     *  were released.
+     *
+     * ---------------------------------------------------------------------- */
+    auto dominators() const -> std::vector<std::size_t>;
+
+    auto retained_sizes(std::vector<std::size_t> const& dominators) const -> std::vector<std::size_t>;
+
+    struct summary
+    {
+      std::size_t count = 0;
+
+      std::size_t size = 0; // shallow size
+
+      std::size_t retained = 0;
+    };
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  The retained size of a type is the sum of the retained sizes of its
+     *  reachable objects that are not dominated by another object of the same
+     *  type, so that nothing is counted twice for the same type.
+     *
+     * ---------------------------------------------------------------------- */
+    auto retained_by_type(std::vector<std::size_t> const& dominators,
+                          std::vector<std::size_t> const& retained_sizes) const -> std::vector<summary>;
+  };
+} // namespace memory
+} // namespace meevax
+
+#endif // INCLUDED_MEEVAX_MEMORY_SNAPSHOT_HPP
@@ -24,37 +24,46 @@ inline namespace memory
 
   static_assert(8 <= sizeof(word));
 
-  template <typename T, typename = void>
-  struct is_immediate
-    : public std::false_type
-  {};
-
-  template <typename T>
-  struct is_immediate<T,
-    typename std::enable_if<(sizeof(T) <= sizeof(word) / 2)>::type>
-    : public std::true_type
-  {};
-
-
   /* ---- Tag ------------------------------------------------------------------
    *
    * ┌─────┬──────────────────────────────────────────────────────────────────┐
    * │ Tag │ Purpose                                                          │
    * ├─────┼──────────────────────────────────────────────────────────────────┤
    * │ 000 │ T* or std::nullptr_t                                             │
-   * │ 001 │                                                                  │
-   * │ 010 │                                                                  │
-   * │ 011 │                                                                  │
-   * │ 100 │                                                                  │
+   * │ 001 │ Exact integer that fits in the payload (fixnum)                  │
+   * │ 010 │ Character                                                        │
+   * │ 011 │ Boolean                                                          │
+   * │ 100 │ Unspecified                                                      │
    * │ 101 │                                                                  │
    * │ 110 │                                                                  │
    * │ 111 │                                                                  │
    * └─────┴──────────────────────────────────────────────────────────────────┘
    *
+   *  Every object in the heap is at least 8 byte aligned, so the low 3 bits of
+   *  a pointer to it are zero. A word with a nonzero tag is an immediate value
+   *  instead: its payload is stored in the upper 32 bits, it is never
+   *  dereferenced, and the collector does not treat it as an address.
+   *
+   *  With compressed references, a cell holds only 32 bits and the payload
+   *  is narrowed to the 29 bits above the tag there (see compress below), so
+   *  payload_min and payload_max are the range that an immediate value can
+   *  carry.
+   *
+   *  The types that have a tag are specialized by the kernel.
+   *
    * ------------------------------------------------------------------------ */
-
   constexpr std::uintptr_t mask { 0x07 };
 
+  template <typename T>
+  struct tag
+    : public std::integral_constant<word, 0b000>
+  {};
+
+  template <typename T>
+  struct is_immediate
+    : public std::integral_constant<bool, tag<T>::value != 0b000>
+  {};
+
   template <typename T>
   constexpr auto tag_of(T const* const address)
   {
@@ -62,30 +71,80 @@ inline namespace memory
   }
 
   template <typename T>
-  constexpr auto type_of(T const* const address) -> const std::type_info&
+  constexpr auto box(std::int32_t const payload) noexcept -> word
   {
-    switch (tag_of(address))
-    {
-    case 0:
-      return typeid(decltype(address));
+    static_assert(is_immediate<T>::value);
+    return static_cast<word>(static_cast<std::uint32_t>(payload)) << 32 | tag<T>::value;
+  }
+
+  template <typename T>
+  constexpr auto unbox(T const* const address) noexcept -> std::int32_t
+  {
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(reinterpret_cast<word>(address) >> 32));
+  }
 
-    default:
-      return typeid(void);
+  #ifdef MEEVAX_COMPRESSED_REFERENCES
+  constexpr std::size_t payload_width = 29;
+  #else
+  constexpr std::size_t payload_width = 32;
+  #endif
+
+  constexpr std::int32_t payload_min = -(std::int64_t(1) << (payload_width - 1));
+
+  constexpr std::int32_t payload_max = (std::int64_t(1) << (payload_width - 1)) - 1;
+
+  /* ---- Compressed References ------------------------------------------------
+   *
+   *  When built with MEEVAX_COMPRESSED_REFERENCES, every page of the heap is
+   *  carved out of a single 4 GiB reservation starting at heap_base, and a
+   *  cell stores a reference as a 32 bit word:
+   *
+   *    null       0
+   *    T*         offset from heap_base (nonzero, as the first word of the
+   *               reservation is a page header)
+   *    immediate  payload << 3 | tag
+   *
+   *  Objects are 8 byte aligned and so is heap_base, so the tag bits of an
+   *  offset are zero as well and the two kinds are told apart by the tag
+   *  alone. decompress restores the full word, so everything above the cell
+   *  sees the same pointers and boxes as without compression.
+   *
+   * ------------------------------------------------------------------------ */
+  inline std::uintptr_t heap_base = 0; // set by the collector on its first page
+
+  using compressed_word = std::uint32_t;
+
+  constexpr auto compress(word const w) noexcept -> compressed_word
+  {
+    if (w & mask)
+    {
+      return static_cast<compressed_word>(w >> 32) << 3 | static_cast<compressed_word>(w & mask);
+    }
+    else if (w)
+    {
+      return static_cast<compressed_word>(w - heap_base);
+    }
+    else
+    {
+      return 0;
     }
   }
 
-  // template <typename T>
-  // constexpr auto unbox(T const* const data) -> std::uintptr_t
-  // {
-  //   switch (tag_of(data))
-  //   {
-  //   case tag<std::int32_t>::value:
-  //     return unbox(data);
-  //
-  //   default:
-  //     throw std::logic_error { "unexpected immediate value" };
-  //   }
-  // }
+  constexpr auto decompress(compressed_word const c) noexcept -> word
+  {
+    if (c & mask)
+    {
+      return static_cast<word>(static_cast<std::uint32_t>(static_cast<std::int32_t>(c) >> 3)) << 32 | (c & mask);
+    }
+    else if (c)
+    {
+      return heap_base + c;
+    }
+    else
+    {
+      return 0;
+    }
+  }
 } // namespace memory
 } // namespace meevax
 
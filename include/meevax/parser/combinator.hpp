@@ -15,7 +15,7 @@ namespace meevax
   template <typename R>
   using parser = std::function<R (input_port &)>;
 
-  auto get_char = [](auto&& port = std::cin)
+  inline auto get_char = [](auto&& port = std::cin)
   {
     codeunit cu {};
 
@@ -49,7 +49,7 @@ namespace meevax
     return cu;
   };
 
-  auto satisfy = [](auto&& check)
+  inline auto satisfy = [](auto&& check)
   {
     return [=](auto&& port)
     {
@@ -67,7 +67,7 @@ namespace meevax
     };
   };
 
-  auto any = satisfy([](auto&&...)
+  inline auto any = satisfy([](auto&&...)
   {
     return true;
   });
@@ -111,7 +111,7 @@ namespace meevax
     return f * k;
   }
 
-  auto many = [](auto&& parse)
+  inline auto many = [](auto&& parse)
   {
     return [=](input_port & port)
     {
@@ -153,7 +153,7 @@ namespace meevax
     };
   }
 
-  auto backtrack = [](auto&& parse)
+  inline auto backtrack = [](auto&& parse)
   {
     return [=](input_port & port)
     {
@@ -171,7 +171,7 @@ namespace meevax
     };
   };
 
-  auto char1 = [](codeunit const& c)
+  inline auto char1 = [](codeunit const& c)
   {
     return satisfy([=](codeunit const& x)
     {
@@ -179,7 +179,7 @@ namespace meevax
     });
   };
 
-  auto string1 = [](codeunits const& s)
+  inline auto string1 = [](codeunits const& s)
   {
     return [=](input_port & port)
     {
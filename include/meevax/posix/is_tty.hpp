@@ -9,7 +9,7 @@ namespace meevax
 {
 inline namespace posix
 {
-  auto is_tty = [](std::ostream& os)
+  inline auto is_tty = [](std::ostream& os)
   {
     if (os.rdbuf() == std::cout.rdbuf())
     {
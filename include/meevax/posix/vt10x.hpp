@@ -43,7 +43,7 @@ inline namespace posix
   #undef DEFINE_CURSOR_MOVE
 
   #define DEFINE_ESCAPE_SEQUENCE(CODE, NAME)                                   \
-  auto NAME = [](std::ostream& os) -> auto&                                    \
+  inline auto NAME = [](std::ostream& os) -> auto&                             \
   {                                                                            \
     return escape_sequence(os, CODE);                                          \
   }
@@ -0,0 +1,358 @@
+#include <deque>
+#include <iomanip>
+#include <unordered_map>
+
+#include <meevax/kernel/code.hpp>
+#include <meevax/kernel/error.hpp>
+#include <meevax/posix/vt10x.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  auto operator <<(std::ostream & os, code const& datum) -> std::ostream &
+  {
+    return os << magenta << "#,("
+              << green << "code" << reset
+              << faint << " #;" << &datum << reset
+              << magenta << ")" << reset;
+  }
+
+  auto assemble(let const& instructions, let const& formals) -> let
+  {
+    let const result = make<code>();
+
+    auto & program = result.as<code>();
+
+    for (let xs = formals; ; xs = cdr(xs))
+    {
+      if (xs.is<pair>())
+      {
+        ++program.arity;
+      }
+      else
+      {
+        program.variadic = not xs.is<null>();
+        break;
+      }
+    }
+
+    std::unordered_map<pointer<pair>, std::size_t> addresses; // of the instruction lists emitted so far
+
+    std::unordered_map<pointer<pair>, std::size_t> indices; // of the constants pooled so far
+
+    std::deque<std::pair<let, std::size_t>> labels; // instruction lists to be emitted, and the operands to refer to them
+
+    auto emit = [&](auto const word)
+    {
+      program.instructions.push_back(static_cast<std::uintptr_t>(word));
+    };
+
+    auto emit_constant = [&](let const& x)
+    {
+      if (auto const iter = indices.find(x.get()); iter != std::end(indices))
+      {
+        emit(iter->second);
+      }
+      else
+      {
+        emit(indices[x.get()] = program.push_constant(x));
+      }
+    };
+
+    auto emit_label = [&](let const& x)
+    {
+      labels.emplace_back(x, std::size(program.instructions));
+      emit(0); // patched when the list is emitted
+    };
+
+    auto emit_count = [&](let const& n)
+    {
+      emit(n.is<exact_integer>() ? n.as<exact_integer>().to<std::size_t>() : operand_list);
+    };
+
+    auto emit_local = [&](let const& index)
+    {
+      emit(car(index).as<exact_integer>().to<std::size_t>());
+      emit(cdr(index).as<exact_integer>().to<std::size_t>());
+    };
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  An instruction that takes one operand in the instruction list and the
+     *  instruction after it are fused into a superinstruction, if there is one
+     *  for the pair (see meevax/kernel/profile.hpp for finding them). A label
+     *  that refers to the second instruction of a pair is given a copy of its
+     *  instruction list, as the instruction has no address of its own.
+     *
+     * ---------------------------------------------------------------------- */
+    auto fuse = [](let const& x, mnemonic const m)
+    {
+      auto followed_by = [&](mnemonic const n) // where x takes one operand
+      {
+        return cddr(x).is<pair>() and car(cddr(x)).as<instruction>().code == n;
+      };
+
+      switch (m)
+      {
+      case mnemonic::LOAD_GLOBAL:
+        return followed_by(mnemonic::CALL)      ? mnemonic::CALL_GLOBAL
+             : followed_by(mnemonic::TAIL_CALL) ? mnemonic::TAIL_CALL_GLOBAL : m;
+
+      case mnemonic::LOAD_CONSTANT:
+        return followed_by(mnemonic::LOAD_LOCAL) ? mnemonic::LOAD_CONSTANT_LOCAL : m;
+
+      case mnemonic::LOAD_LOCAL:
+        return followed_by(mnemonic::LOAD_LOCAL) ? mnemonic::LOAD_LOCAL_LOCAL : m;
+
+      default:
+        return m;
+      }
+    };
+
+    auto emit_list = [&](let const& c)
+    {
+      for (let x = c; x; )
+      {
+        addresses.emplace(x.get(), std::size(program.instructions)); // the first emission is the one referred to
+
+        auto const m = fuse(x, car(x).as<instruction>().code);
+
+        emit(m);
+
+        switch (m)
+        {
+        case mnemonic::CONS:
+        case mnemonic::DROP:
+        case mnemonic::JOIN:
+        case mnemonic::RETURN:
+        case mnemonic::STOP:
+          x = cdr(x);
+          break;
+
+        case mnemonic::CALL:
+        case mnemonic::TAIL_CALL:
+          emit_count(cadr(x));
+          emit(program.push_cache());
+          x = cddr(x);
+          break;
+
+        case mnemonic::CALL_GLOBAL:
+        case mnemonic::TAIL_CALL_GLOBAL:
+          emit_constant(cadr(x));
+          emit_count(cadddr(x));
+          emit(program.push_cache());
+          x = cddddr(x);
+          break;
+
+        case mnemonic::LOAD_CONSTANT_LOCAL:
+          emit_constant(cadr(x));
+          emit_local(cadddr(x));
+          x = cddddr(x);
+          break;
+
+        case mnemonic::LOAD_LOCAL_LOCAL:
+          emit_local(cadr(x));
+          emit_local(cadddr(x));
+          x = cddddr(x);
+          break;
+
+        case mnemonic::DEFINE:
+        case mnemonic::FORK:
+        case mnemonic::LOAD_CONSTANT:
+        case mnemonic::LOAD_GLOBAL:
+        case mnemonic::STORE_GLOBAL:
+        case mnemonic::STRIP:
+          emit_constant(cadr(x));
+          x = cddr(x);
+          break;
+
+        case mnemonic::ADD2:
+        case mnemonic::CAR:
+        case mnemonic::CDR:
+        case mnemonic::EQ:
+        case mnemonic::NULLP:
+        case mnemonic::NUMEQ2:
+        case mnemonic::NUMLT2:
+        case mnemonic::SUB2:
+          emit_constant(cadr(x));
+          emit_constant(caddr(x));
+          x = cdddr(x);
+          break;
+
+        case mnemonic::LOAD_LOCAL:
+        case mnemonic::STORE_LOCAL:
+          emit_local(cadr(x));
+          x = cddr(x);
+          break;
+
+        case mnemonic::LOAD_CLOSURE:
+          emit(program.push_constant(assemble(caddr(x), cadr(x))));
+          x = cdddr(x);
+          break;
+
+        case mnemonic::LOAD_CONTINUATION:
+          emit_label(cadr(x));
+          x = cddr(x);
+          break;
+
+        case mnemonic::SELECT:
+        case mnemonic::TAIL_SELECT:
+          emit_label(cadr(x));
+          emit_label(caddr(x));
+          x = cdddr(x);
+          break;
+
+        default:
+          throw error(make<string>("assemble: unknown instruction"), car(x));
+        }
+      }
+    };
+
+    for (emit_list(instructions); not labels.empty(); labels.pop_front())
+    {
+      auto const& [x, operand] = labels.front();
+
+      if (auto const iter = addresses.find(x.get()); iter != std::end(addresses))
+      {
+        program.instructions[operand] = iter->second;
+      }
+      else
+      {
+        program.instructions[operand] = std::size(program.instructions);
+        emit_list(x);
+      }
+    }
+
+    program.instructions.shrink_to_fit();
+
+    return result;
+  }
+
+  auto disassemble(std::ostream & os, let const& c, std::size_t depth) -> std::ostream &
+  {
+    assert(0 < depth);
+
+    auto const& program = c.as<code>();
+
+    auto const size = std::size(program.instructions);
+
+    for (std::size_t pc = 0; pc < size; )
+    {
+      os << faint << "; " << std::setw(4) << std::right << std::to_string(pc) << "  " << reset;
+
+      if (pc == 0)
+      {
+        os << std::string(4 * (depth - 1), ' ') << magenta << "(   " << reset;
+      }
+      else
+      {
+        os << std::string(4 * depth, ' ');
+      }
+
+      auto const m = program.opcode(pc);
+
+      os << instruction(m);
+
+      switch (m)
+      {
+      case mnemonic::CONS:
+      case mnemonic::DROP:
+      case mnemonic::JOIN:
+      case mnemonic::RETURN:
+      case mnemonic::STOP:
+        pc += 1;
+        break;
+
+      case mnemonic::CALL:
+      case mnemonic::TAIL_CALL:
+        if (program[pc + 1] == operand_list)
+        {
+          os << " " << f;
+        }
+        else
+        {
+          os << " " << program[pc + 1];
+        }
+        pc += 3;
+        break;
+
+      case mnemonic::CALL_GLOBAL:
+      case mnemonic::TAIL_CALL_GLOBAL:
+        os << " " << car(program.constant(program[pc + 1])) << " " << program[pc + 2];
+        pc += 4;
+        break;
+
+      case mnemonic::LOAD_CONSTANT_LOCAL:
+        os << " " << program.constant(program[pc + 1]) << " " << program[pc + 2] << " " << program[pc + 3];
+        pc += 4;
+        break;
+
+      case mnemonic::LOAD_LOCAL_LOCAL:
+        os << " " << program[pc + 1] << " " << program[pc + 2] << " " << program[pc + 3] << " " << program[pc + 4];
+        pc += 5;
+        break;
+
+      case mnemonic::FORK:
+      case mnemonic::LOAD_CONSTANT:
+      case mnemonic::STRIP:
+        os << " " << program.constant(program[pc + 1]);
+        pc += 2;
+        break;
+
+      case mnemonic::DEFINE:
+      case mnemonic::LOAD_GLOBAL:
+      case mnemonic::STORE_GLOBAL:
+        os << " " << car(program.constant(program[pc + 1]));
+        pc += 2;
+        break;
+
+      case mnemonic::ADD2:
+      case mnemonic::CAR:
+      case mnemonic::CDR:
+      case mnemonic::EQ:
+      case mnemonic::NULLP:
+      case mnemonic::NUMEQ2:
+      case mnemonic::NUMLT2:
+      case mnemonic::SUB2:
+        os << " " << car(program.constant(program[pc + 1]));
+        pc += 3;
+        break;
+
+      case mnemonic::LOAD_CONTINUATION:
+        os << " " << program[pc + 1];
+        pc += 2;
+        break;
+
+      case mnemonic::LOAD_LOCAL:
+      case mnemonic::SELECT:
+      case mnemonic::STORE_LOCAL:
+      case mnemonic::TAIL_SELECT:
+        os << " " << program[pc + 1] << " " << program[pc + 2];
+        pc += 3;
+        break;
+
+      case mnemonic::LOAD_CLOSURE:
+        os << "\n";
+        disassemble(os, program.constant(program[pc + 1]), depth + 1);
+        pc += 2;
+        continue;
+
+      default:
+        assert(false);
+        pc += 1;
+        break;
+      }
+
+      if (pc == size)
+      {
+        os << magenta << "\t)" << reset;
+      }
+
+      os << "\n";
+    }
+
+    return os;
+  }
+} // namespace kernel
+} // namespace meevax
@@ -0,0 +1,26 @@
+#include <meevax/kernel/ephemeron.hpp>
+#include <meevax/posix/vt10x.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  auto ephemeron::key() const -> let
+  {
+    return broken() ? f : static_cast<let>(static_cast<pointer<pair>>(collector::ephemeron::key()));
+  }
+
+  auto ephemeron::datum() const -> let
+  {
+    return broken() ? f : static_cast<let>(static_cast<pointer<pair>>(collector::ephemeron::datum()));
+  }
+
+  auto operator <<(std::ostream & port, ephemeron const& datum) -> std::ostream &
+  {
+    return port << magenta << "#,("
+                << green << "ephemeron" << reset
+                << faint << " #;" << &datum << reset
+                << magenta << ")" << reset;
+  }
+} // namespace kernel
+} // namespace meevax
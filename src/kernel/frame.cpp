@@ -0,0 +1,20 @@
+#include <meevax/kernel/frame.hpp>
+#include <meevax/posix/vt10x.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  auto operator <<(std::ostream & os, frame const& datum) -> std::ostream &
+  {
+    os << magenta << "#,(" << green << "frame" << reset;
+
+    for (std::size_t index = 0; index < datum.size; ++index)
+    {
+      os << " " << datum[index];
+    }
+
+    return os << magenta << ")" << reset;
+  }
+} // namespace kernel
+} // namespace meevax
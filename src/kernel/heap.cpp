@@ -0,0 +1,90 @@
+#include <csignal>
+#include <fstream>
+#include <typeindex>
+
+#include <meevax/kernel/error.hpp>
+#include <meevax/kernel/heap.hpp>
+#include <meevax/utility/demangle.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  auto census() -> std::map<std::string, std::size_t>
+  {
+    std::map<std::type_index, std::size_t> counts;
+
+    gc.for_each_object<pair>([&](auto && x)
+    {
+      ++counts[x->type()];
+    });
+
+    std::map<std::string, std::size_t> result;
+
+    for (auto const& [type, count] : counts)
+    {
+      result[demangle(type.name())] += count;
+    }
+
+    return result;
+  }
+
+  auto take_heap_snapshot() -> snapshot
+  {
+    gc.collect();
+
+    std::unordered_map<std::type_index, std::string> names;
+
+    return snapshot::take([&](auto && r) -> std::string const&
+    {
+      if (r->assigned(deallocator<pair>::deallocate))
+      {
+        auto const& type = static_cast<pointer<pair>>(r->derived())->type();
+
+        if (auto const iter = names.find(type); iter != std::end(names))
+        {
+          return iter->second;
+        }
+        else
+        {
+          return names.emplace(type, demangle(type)).first->second;
+        }
+      }
+      else
+      {
+        static std::string const unknown = "(under construction)";
+        return unknown;
+      }
+    });
+  }
+
+  void dump_heap(std::string const& path)
+  {
+    if (std::ofstream os { path }; os)
+    {
+      take_heap_snapshot().write(os);
+    }
+    else
+    {
+      throw file_error(make<string>("failed to open file for heap snapshot"), list(make<string>(path)));
+    }
+  }
+
+  static std::string signal_dump_path;
+
+  void dump_heap_on_signal(std::string const& path)
+  {
+    signal_dump_path = path;
+
+    std::signal(SIGUSR1, [](int)
+    {
+      collector::interrupt(collector::heap_dump);
+    });
+  }
+
+  auto heap_dump_path() -> std::string const&
+  {
+    return signal_dump_path;
+  }
+} // namespace kernel
+} // namespace meevax
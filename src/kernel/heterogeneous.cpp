@@ -0,0 +1,26 @@
+#include <meevax/kernel/boolean.hpp>
+#include <meevax/kernel/character.hpp>
+#include <meevax/kernel/exact_integer.hpp>
+#include <meevax/kernel/ghost.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  auto type_of_immediate(let const& datum) -> std::type_info const&
+  {
+    return datum.visit([](auto&& x) -> std::type_info const&
+    {
+      return typeid(x);
+    });
+  }
+
+  auto write_immediate(output_port & port, let const& datum) -> output_port &
+  {
+    return datum.visit([&](auto&& x) -> output_port &
+    {
+      return delay<write>().yield<output_port &>(port, x);
+    });
+  }
+} // namespace kernel
+} // namespace meevax
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+#include <meevax/kernel/profile.hpp>
+#include <meevax/string/header.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  void profile::report()
+  {
+    auto const header = meevax::header("profile");
+
+    auto display = [&](std::vector<std::size_t> const& counts, std::size_t const length)
+    {
+      std::vector<std::size_t> indices;
+
+      for (std::size_t index = 0; index < std::size(counts); ++index)
+      {
+        if (counts[index])
+        {
+          indices.push_back(index);
+        }
+      }
+
+      auto const top = std::min<std::size_t>(std::size(indices), 16);
+
+      std::partial_sort(std::begin(indices), std::next(std::begin(indices), top), std::end(indices), [&](auto a, auto b)
+      {
+        return counts[b] < counts[a];
+      });
+
+      std::cerr << header << std::accumulate(std::begin(counts), std::end(counts), std::size_t(0));
+
+      if (length == 1)
+      {
+        std::cerr << " instructions executed, most frequent first\n";
+      }
+      else
+      {
+        std::cerr << " sequences of " << length << " instructions, most frequent first\n";
+      }
+
+      for (std::size_t rank = 0; rank < top; ++rank)
+      {
+        std::cerr << header << "  " << counts[indices[rank]];
+
+        for (std::size_t digit = length; 0 < digit--; )
+        {
+          auto index = indices[rank];
+
+          for (std::size_t power = 0; power < digit; ++power)
+          {
+            index /= size;
+          }
+
+          std::cerr << " " << static_cast<mnemonic>(index % size);
+        }
+
+        std::cerr << "\n";
+      }
+    };
+
+    display(unigrams, 1);
+    display(bigrams, 2);
+    display(trigrams, 3);
+  }
+} // namespace kernel
+} // namespace meevax
@@ -5,12 +5,12 @@ namespace meevax
 {
 inline namespace kernel
 {
-  auto ratio::numerator() const -> exact_integer const&
+  auto ratio::numerator() const -> exact_integer
   {
     return std::get<0>(*this).as<exact_integer>();
   }
 
-  auto ratio::denominator() const -> exact_integer const&
+  auto ratio::denominator() const -> exact_integer
   {
     return std::get<1>(*this).as<exact_integer>();
   }
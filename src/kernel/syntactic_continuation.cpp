@@ -2,11 +2,16 @@
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/range/adaptors.hpp>
 
+#include <fstream>
 #include <ios>
 #include <iterator>
+#include <numeric>
 #include <meevax/kernel/basis.hpp>
+#include <meevax/kernel/ephemeron.hpp>
 #include <meevax/kernel/feature.hpp>
+#include <meevax/kernel/heap.hpp>
 #include <meevax/kernel/syntactic_continuation.hpp>
+#include <meevax/kernel/weak_table.hpp>
 #include <meevax/posix/vt10x.hpp>
 
 namespace meevax
@@ -138,9 +143,9 @@ inline namespace kernel
      *
      * ---------------------------------------------------------------------- */
 
-    define<procedure>("eq?", [](auto&& xs)
+    define<procedure>("eq?", procedure::fixed<2>, [](let const& a, let const& b)
     {
-      return car(xs) == cadr(xs) ? t : f;
+      return a == b ? t : f;
     });
 
     /* -------------------------------------------------------------------------
@@ -230,23 +235,23 @@ inline namespace kernel
      *
      * ---------------------------------------------------------------------- */
 
-    #define BOILERPLATE(SYMBOL, OPERATOR)                                      \
+    #define BOILERPLATE(SYMBOL, FUNCTOR)                                       \
     define<procedure>(#SYMBOL, [](auto&& xs) constexpr                         \
     {                                                                          \
       const auto compare = std::not_fn([](let const& a, let const& b)          \
       {                                                                        \
-        return a.load() OPERATOR b;                                            \
+        return dispatch<FUNCTOR>(a, b);                                        \
       });                                                                      \
                                                                                \
       return std::adjacent_find(                                               \
         std::cbegin(xs), std::cend(xs), compare) == std::end(xs) ? t : f;      \
     })
 
-    BOILERPLATE(= , ==);
-    BOILERPLATE(< , < );
-    BOILERPLATE(<=, <=);
-    BOILERPLATE(> , > );
-    BOILERPLATE(>=, >=);
+    BOILERPLATE(= , std::equal_to     <void>);
+    BOILERPLATE(< , std::less         <void>);
+    BOILERPLATE(<=, std::less_equal   <void>);
+    BOILERPLATE(> , std::greater      <void>);
+    BOILERPLATE(>=, std::greater_equal<void>);
 
     #undef BOILERPLATE
 
@@ -491,6 +496,16 @@ inline namespace kernel
 
     define<procedure>("pair?", is<pair>());
 
+    /* -------------------------------------------------------------------------
+     *
+     *  (null? obj)                                                   procedure
+     *
+     *  Returns #t if obj is the empty list, otherwise returns #f.
+     *
+     * ---------------------------------------------------------------------- */
+
+    define<procedure>("null?", is<null>());
+
     /* -------------------------------------------------------------------------
      *
      *  (cons obj1 obj2)                                              procedure
@@ -501,9 +516,9 @@ inline namespace kernel
      *
      * ---------------------------------------------------------------------- */
 
-    define<procedure>("cons", [](auto&& xs)
+    define<procedure>("cons", procedure::fixed<2>, [](let const& a, let const& b)
     {
-      return cons(car(xs), cadr(xs));
+      return cons(a, b);
     });
 
     /* -------------------------------------------------------------------------
@@ -520,8 +535,8 @@ inline namespace kernel
      *
      * ---------------------------------------------------------------------- */
 
-    define<procedure>("car", [](auto&& xs) { return caar(xs); });
-    define<procedure>("cdr", [](auto&& xs) { return cdar(xs); });
+    define<procedure>("car", procedure::fixed<1>, [](let const& x) { return car(x); });
+    define<procedure>("cdr", procedure::fixed<1>, [](let const& x) { return cdr(x); });
 
     /* -------------------------------------------------------------------------
      *
@@ -533,10 +548,26 @@ inline namespace kernel
      *
      *  Stores obj in the cdr field of pair.
      *
+     *  The car and cdr of the empty list and of an immediate value (see
+     *  meevax/kernel/heterogeneous.hpp) have no storage of their own, so
+     *  storing into them is an error.
+     *
      * ---------------------------------------------------------------------- */
 
-    define<procedure>("set-car!", [](auto&& xs) { return caar(xs) = cadr(xs); });
-    define<procedure>("set-cdr!", [](auto&& xs) { return cdar(xs) = cadr(xs); });
+    static auto const mutable_pair = [](let const& x) -> let const&
+    {
+      if (x.is<null>() or tag_of(x.get()))
+      {
+        throw error(make<string>("not a mutable pair"), x);
+      }
+      else
+      {
+        return x;
+      }
+    };
+
+    define<procedure>("set-car!", procedure::fixed<2>, [](let const& x, let const& y) { return car(mutable_pair(x)) = y; });
+    define<procedure>("set-cdr!", procedure::fixed<2>, [](let const& x, let const& y) { return cdr(mutable_pair(x)) = y; });
 
 
     /* -------------------------------------------------------------------------
@@ -782,9 +813,9 @@ inline namespace kernel
      *
      * ---------------------------------------------------------------------- */
 
-    define<procedure>("string-ref", [](let const& xs)
+    define<procedure>("string-ref", procedure::fixed<2>, [](let const& s, let const& k)
     {
-      return make(car(xs).as<string const>().at(cadr(xs).as<exact_integer>().to<string::size_type>()));
+      return make(s.as<string const>().at(k.as<exact_integer>().to<string::size_type>()));
     });
 
     /* -------------------------------------------------------------------------
@@ -1050,22 +1081,19 @@ inline namespace kernel
       return make<vector>(for_each_in, std::forward<decltype(xs)>(xs)...);
     });
 
-    define<procedure>("vector-length", [](let const& xs)
+    define<procedure>("vector-length", procedure::fixed<1>, [](let const& v)
     {
-      return make<exact_integer>(car(xs).as<vector>().size());
+      return make<exact_integer>(v.as<vector>().size());
     });
 
-    define<procedure>("vector-ref", [](let const& xs)
+    define<procedure>("vector-ref", procedure::fixed<2>, [](let const& v, let const& k)
     {
-      return car(xs).as<vector>().at(
-               cadr(xs).as<exact_integer>().to<vector::size_type>());
+      return v.as<vector>().at(k.as<exact_integer>().to<vector::size_type>());
     });
 
-    define<procedure>("vector-set!", [](let const& xs)
+    define<procedure>("vector-set!", procedure::fixed<3>, [](let const& v, let const& k, let const& x)
     {
-      return car(xs).as<vector>().at(
-               cadr(xs).as<exact_integer>().to<vector::size_type>())
-             = caddr(xs);
+      return v.as<vector>().at(k.as<exact_integer>().to<vector::size_type>()) = x;
     });
 
     define<procedure>("vector->list", [](let const& xs)
@@ -1627,11 +1655,11 @@ inline namespace kernel
      ├───────────────────────────┼────────────┼──────────────────────────────────┤
      │ get-environment-variables │ TODO       │ (scheme process-context) library │
      ├───────────────────────────┼────────────┼──────────────────────────────────┤
-     │ current-second            │ TODO       │ (scheme time) library            │
+     │ current-second            │ C++        │ (scheme time) library            │
      ├───────────────────────────┼────────────┼──────────────────────────────────┤
-     │ current-jiffy             │ TODO       │ (scheme time) library            │
+     │ current-jiffy             │ C++        │ (scheme time) library            │
      ├───────────────────────────┼────────────┼──────────────────────────────────┤
-     │ jiffies-per-second        │ TODO       │ (scheme time) library            │
+     │ jiffies-per-second        │ C++        │ (scheme time) library            │
      ├───────────────────────────┼────────────┼──────────────────────────────────┤
      │ features                  │ C++        │                                  │
      └───────────────────────────┴────────────┴──────────────────────────────────┘
@@ -1673,6 +1701,50 @@ inline namespace kernel
       }
     });
 
+    /* -------------------------------------------------------------------------
+     *
+     *  (current-second)                                time library procedure
+     *
+     *  Returns an inexact number representing the current time on the
+     *  International Atomic Time (TAI) scale. This implementation returns the
+     *  POSIX time (UTC) instead, as permitted by R7RS.
+     *
+     * ---------------------------------------------------------------------- */
+
+    define<procedure>("current-second", [](auto&&)
+    {
+      return make<system_float>(std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count());
+    });
+
+    /* -------------------------------------------------------------------------
+     *
+     *  (current-jiffy)                                 time library procedure
+     *
+     *  Returns the number of jiffies as an exact integer that have elapsed
+     *  since an arbitrary, implementation-defined epoch. A jiffy is one
+     *  microsecond of a monotonic clock.
+     *
+     * ---------------------------------------------------------------------- */
+
+    define<procedure>("current-jiffy", [](auto&&)
+    {
+      return make<exact_integer>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    });
+
+    /* -------------------------------------------------------------------------
+     *
+     *  (jiffies-per-second)                            time library procedure
+     *
+     *  Returns an exact integer representing the number of jiffies per SI
+     *  second.
+     *
+     * ---------------------------------------------------------------------- */
+
+    define<procedure>("jiffies-per-second", [](auto&&)
+    {
+      return make<exact_integer>(std::micro::den);
+    });
+
     define<procedure>("linker", [](auto&& xs)
     {
       return make<linker>(car(xs).template as<const string>());
@@ -1744,6 +1816,32 @@ inline namespace kernel
         return x.is<syntactic_keyword>() or x.is<symbol>() ? t : f;
       }
     });
+
+    /* ---- Arenas -------------------------------------------------------------
+     *
+     *  (gc-open-arena)                                               procedure
+     *  (gc-close-arena)                                              procedure
+     *
+     *  Opens and closes an arena for the objects allocated in between (see
+     *  collector::arena). Closing an arena runs a minor collection, frees the
+     *  pages of the arena that nothing escaped from, and returns the number
+     *  of objects freed. call-with-arena in overture.ss wraps a thunk in an
+     *  arena.
+     *
+     * ---------------------------------------------------------------------- */
+
+    define<procedure>("gc-open-arena", [](auto&&)
+    {
+      collector::open_arena();
+      return unspecified;
+    });
+
+    define<procedure>("gc-close-arena", [](auto&&)
+    {
+      auto const before = gc.count();
+      collector::close_arena();
+      return make<exact_integer>(before - gc.count());
+    });
   }
 
   template <>
@@ -1799,6 +1897,340 @@ inline namespace kernel
       return make<exact_integer>(gc.count());
     });
 
+    define<procedure>("gc-collecting?", [](auto&&)
+    {
+      return gc.collecting() ? t : f;
+    });
+
+    define<procedure>("gc-pause-budget", [](let const& xs)
+    {
+      if (xs.is<pair>())
+      {
+        gc.reset_pause_budget(std::chrono::microseconds(car(xs).as<exact_integer>().to<std::size_t>()));
+      }
+
+      return make<exact_integer>(gc.pause_budget().count());
+    });
+
+    /* -------------------------------------------------------------------------
+     *
+     *  (gc-dump-heap filename)                                       procedure
+     *
+     *  Collects garbage and writes a snapshot of the live objects, their types,
+     *  sizes and references, and the roots to the file named filename, in the
+     *  JSON format described in meevax/memory/snapshot.hpp.
+     *
+     *  (gc-analyze-heap)                                             procedure
+     *  (gc-analyze-heap filename)                                    procedure
+     *
+     *  Analyzes a snapshot of the heap, or the snapshot in the file named
+     *  filename, and returns an association list of: the number of objects and
+     *  their total size; for each type, a list of the name, the number of
+     *  objects, their size and their retained size, in decreasing order of
+     *  retained size; and for the objects that retain the most, a list of the
+     *  name of the type, the size and the retained size. The retained size of
+     *  an object is the size of the objects that would be freed with it.
+     *
+     * ---------------------------------------------------------------------- */
+
+    define<procedure>("gc-dump-heap", [](let const& xs)
+    {
+      dump_heap(static_cast<std::string>(car(xs).as<string>()));
+      return unspecified;
+    });
+
+    define<procedure>("gc-analyze-heap", [](let const& xs)
+    {
+      auto const heap = [&]()
+      {
+        if (xs.is<pair>())
+        {
+          if (std::ifstream is { static_cast<std::string>(car(xs).as<string>()) }; is)
+          {
+            return snapshot::read(is);
+          }
+          else
+          {
+            throw file_error(make<string>("failed to open file"), xs);
+          }
+        }
+        else
+        {
+          return take_heap_snapshot();
+        }
+      }();
+
+      auto const dominators = heap.dominators();
+
+      auto const retained = heap.retained_sizes(dominators);
+
+      auto const summaries = heap.retained_by_type(dominators, retained);
+
+      std::size_t bytes = 0;
+
+      for (auto const& object : heap.objects)
+      {
+        bytes += object.size;
+      }
+
+      std::vector<std::size_t> types(std::size(heap.types));
+
+      std::iota(std::begin(types), std::end(types), 0);
+
+      std::sort(std::begin(types), std::end(types), [&](auto a, auto b)
+      {
+        return summaries[b].retained < summaries[a].retained;
+      });
+
+      let by_type = unit;
+
+      for (auto type : boost::adaptors::reverse(types))
+      {
+        if (summaries[type].count)
+        {
+          by_type = cons(list(make<string>(heap.types[type]),
+                              make<exact_integer>(summaries[type].count),
+                              make<exact_integer>(summaries[type].size),
+                              make<exact_integer>(summaries[type].retained)), by_type);
+        }
+      }
+
+      std::vector<std::size_t> objects(std::size(heap.objects));
+
+      std::iota(std::begin(objects), std::end(objects), 0);
+
+      auto const top = std::min<std::size_t>(std::size(objects), 16);
+
+      std::partial_sort(std::begin(objects), std::next(std::begin(objects), top), std::end(objects), [&](auto a, auto b)
+      {
+        return retained[b] < retained[a];
+      });
+
+      let largest = unit;
+
+      for (auto i = top; 0 < i--; )
+      {
+        largest = cons(list(make<string>(heap.types[heap.objects[objects[i]].type]),
+                            make<exact_integer>(heap.objects[objects[i]].size),
+                            make<exact_integer>(retained[objects[i]])), largest);
+      }
+
+      return list(cons(intern("objects"), make<exact_integer>(std::size(heap.objects))),
+                  cons(intern("bytes"), make<exact_integer>(bytes)),
+                  cons(intern("retained-by-type"), by_type),
+                  cons(intern("dominators"), largest));
+    });
+
+    define<procedure>("gc-heap-growth", [](let const& xs)
+    {
+      if (xs.is<pair>())
+      {
+        gc.reset_heap_growth(inexact(car(xs)).as<double_float>());
+      }
+
+      return make<double_float>(gc.heap_growth());
+    });
+
+    /* -------------------------------------------------------------------------
+     *
+     *  (gc-heap-limit)                                               procedure
+     *  (gc-heap-limit k)                                             procedure
+     *
+     *  Limits the heap to k bytes, or removes the limit if k is #f, and returns
+     *  the limit in effect. When the heap cannot be kept under the limit, an
+     *  error object with the message "heap exhausted" is raised by the next
+     *  procedure call.
+     *
+     * ---------------------------------------------------------------------- */
+
+    define<procedure>("gc-heap-limit", [](let const& xs)
+    {
+      if (xs.is<pair>())
+      {
+        gc.reset_heap_limit(car(xs).is<exact_integer>() ? car(xs).as<exact_integer>().to<std::size_t>()
+                                                        : std::numeric_limits<std::size_t>::max());
+      }
+
+      if (gc.heap_limit() < std::numeric_limits<std::size_t>::max())
+      {
+        return make<exact_integer>(gc.heap_limit());
+      }
+      else
+      {
+        return f;
+      }
+    });
+
+    define<procedure>("gc-mark-threads", [](let const& xs)
+    {
+      if (xs.is<pair>())
+      {
+        gc.reset_mark_threads(car(xs).as<exact_integer>().to<std::size_t>());
+      }
+
+      return make<exact_integer>(gc.mark_threads());
+    });
+
+    define<procedure>("gc-mark-stack-limit", [](let const& xs)
+    {
+      if (xs.is<pair>())
+      {
+        gc.reset_mark_stack_limit(car(xs).as<exact_integer>().to<std::size_t>());
+      }
+
+      return make<exact_integer>(gc.mark_stack_limit());
+    });
+
+    define<procedure>("gc-max-threshold", [](let const& xs)
+    {
+      if (xs.is<pair>())
+      {
+        gc.reset_max_threshold(car(xs).as<exact_integer>().to<std::size_t>());
+      }
+
+      return make<exact_integer>(gc.max_threshold());
+    });
+
+    define<procedure>("gc-min-threshold", [](let const& xs)
+    {
+      if (xs.is<pair>())
+      {
+        gc.reset_min_threshold(car(xs).as<exact_integer>().to<std::size_t>());
+      }
+
+      return make<exact_integer>(gc.min_threshold());
+    });
+
+    /* -------------------------------------------------------------------------
+     *
+     *  (gc-statistics)                                               procedure
+     *
+     *  Returns an association list of the cumulative statistics of the garbage
+     *  collector. Times are in microseconds. The value of pause-histogram is a
+     *  list whose k-th element counts the pauses shorter than 2^k microseconds
+     *  but not shorter than 2^(k-1), the value of large-object-bytes is the
+     *  number of bytes of the payloads of vectors and strings held in the
+     *  large object space, mark-stack-overflows counts the markings that ran
+     *  out of mark stack (see gc-mark-stack-limit), and the value of census
+     *  is an association list from the names of the types of the objects in
+     *  the heap to their numbers.
+     *
+     * ---------------------------------------------------------------------- */
+
+    define<procedure>("gc-statistics", [](auto&&)
+    {
+      auto const& stats = gc.stats();
+
+      auto microseconds = [](auto const& duration)
+      {
+        return make<exact_integer>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+      };
+
+      let histogram = unit;
+
+      for (auto const& count : boost::adaptors::reverse(stats.pause_histogram))
+      {
+        histogram = cons(make<exact_integer>(count), histogram);
+      }
+
+      let types = unit;
+
+      for (auto const& [name, count] : census())
+      {
+        types = cons(cons(make<string>(name), make<exact_integer>(count)), types);
+      }
+
+      return list(cons(intern("allocated-bytes"),   make<exact_integer>(stats.allocated_bytes)),
+                  cons(intern("allocated-objects"), make<exact_integer>(stats.allocated_objects)),
+                  cons(intern("minor-collections"), make<exact_integer>(stats.minor_collections)),
+                  cons(intern("major-collections"), make<exact_integer>(stats.major_collections)),
+                  cons(intern("mark-time"),         microseconds(stats.mark_time)),
+                  cons(intern("sweep-time"),        microseconds(stats.sweep_time)),
+                  cons(intern("last-mark-time"),    microseconds(stats.last_mark_time)),
+                  cons(intern("last-sweep-time"),   microseconds(stats.last_sweep_time)),
+                  cons(intern("total-pause"),       microseconds(stats.total_pause)),
+                  cons(intern("max-pause"),         microseconds(stats.max_pause)),
+                  cons(intern("pause-histogram"),   histogram),
+                  cons(intern("live-bytes"),        make<exact_integer>(stats.live_bytes)),
+                  cons(intern("live-objects"),      make<exact_integer>(stats.live_objects)),
+                  cons(intern("large-object-bytes"), make<exact_integer>(stats.large_object_bytes)),
+                  cons(intern("mark-stack-overflows"), make<exact_integer>(stats.mark_stack_overflows)),
+                  cons(intern("census"),            reverse(types)));
+    });
+
+    /* ---- SRFI 124 Ephemerons ------------------------------------------------
+     *
+     *  An ephemeron is broken by the first collection that finds its key
+     *  unreachable except through ephemerons, after which its key and datum
+     *  are #f. (reference-barrier x) keeps x alive until it returns.
+     *
+     * ---------------------------------------------------------------------- */
+
+    define<procedure>("ephemeron?", is<ephemeron>());
+
+    define<procedure>("make-ephemeron", [](let const& xs)
+    {
+      return make<ephemeron>(car(xs), cadr(xs));
+    });
+
+    define<procedure>("ephemeron-broken?", [](let const& xs)
+    {
+      return car(xs).as<ephemeron>().broken() ? t : f;
+    });
+
+    define<procedure>("ephemeron-key", [](let const& xs)
+    {
+      return car(xs).as<ephemeron>().key();
+    });
+
+    define<procedure>("ephemeron-datum", [](let const& xs)
+    {
+      return car(xs).as<ephemeron>().datum();
+    });
+
+    define<procedure>("reference-barrier", [](auto&&)
+    {
+      return unspecified;
+    });
+
+    /* ---- Weak Tables --------------------------------------------------------
+     *
+     *  A weak table maps keys compared by eq? to values without keeping them
+     *  alive (see meevax/kernel/weak_table.hpp). weak-table-ref returns its
+     *  optional third argument, or #f, if the key is not in the table, and
+     *  weak-table-count counts the entries whose keys are still alive.
+     *
+     * ---------------------------------------------------------------------- */
+
+    define<procedure>("weak-table?", is<weak_table>());
+
+    define<procedure>("make-weak-table", [](auto&&)
+    {
+      return make<weak_table>();
+    });
+
+    define<procedure>("weak-table-ref", [](let const& xs)
+    {
+      return car(xs).as<weak_table>().ref(cadr(xs), cddr(xs).is<pair>() ? caddr(xs) : f);
+    });
+
+    define<procedure>("weak-table-set!", [](let const& xs)
+    {
+      car(xs).as<weak_table>().set(cadr(xs), caddr(xs));
+      return unspecified;
+    });
+
+    define<procedure>("weak-table-delete!", [](let const& xs)
+    {
+      car(xs).as<weak_table>().erase(cadr(xs));
+      return unspecified;
+    });
+
+    define<procedure>("weak-table-count", [](let const& xs)
+    {
+      return make<exact_integer>(car(xs).as<weak_table>().size());
+    });
+
     define<procedure>("ieee-float?", [](auto&&)
     {
       return std::numeric_limits<double>::is_iec559 ? t : f;
@@ -0,0 +1,71 @@
+#include <meevax/kernel/weak_table.hpp>
+#include <meevax/posix/vt10x.hpp>
+
+namespace meevax
+{
+inline namespace kernel
+{
+  namespace
+  {
+    auto address_of(let const& x)
+    {
+      return reinterpret_cast<std::uintptr_t>(x.get());
+    }
+  } // namespace
+
+  auto weak_table::ref(let const& key, let const& default_value) const -> let
+  {
+    if (auto const iter = entries.find(address_of(key)); iter != std::end(entries) and not iter->second.broken())
+    {
+      return static_cast<let>(static_cast<pointer<pair>>(iter->second.datum()));
+    }
+    else
+    {
+      return default_value;
+    }
+  }
+
+  void weak_table::set(let const& key, let const& value)
+  {
+    if (auto const [iter, inserted] = entries.try_emplace(address_of(key), key.get(), value.get()); not inserted)
+    {
+      iter->second.reset(key.get(), value.get());
+    }
+    else if (purge_at <= std::size(entries))
+    {
+      purge();
+    }
+  }
+
+  void weak_table::erase(let const& key)
+  {
+    entries.erase(address_of(key));
+  }
+
+  auto weak_table::size() const -> std::size_t
+  {
+    return std::count_if(std::begin(entries), std::end(entries), [](auto const& entry)
+    {
+      return not entry.second.broken();
+    });
+  }
+
+  void weak_table::purge()
+  {
+    for (auto iter = std::begin(entries); iter != std::end(entries); )
+    {
+      iter = iter->second.broken() ? entries.erase(iter) : std::next(iter);
+    }
+
+    purge_at = std::max<std::size_t>(std::size(entries) * 2, 8);
+  }
+
+  auto operator <<(std::ostream & port, weak_table const& datum) -> std::ostream &
+  {
+    return port << magenta << "#,("
+                << green << "weak-table" << reset
+                << faint << " #;" << &datum << reset
+                << magenta << ")" << reset;
+  }
+} // namespace kernel
+} // namespace meevax
@@ -1,3 +1,11 @@
+#include <atomic>
+#include <cstdlib> // std::aligned_alloc, std::free
+#include <deque>
+#include <memory> // std::make_unique
+#include <sys/mman.h> // mmap, madvise, munmap
+#include <unordered_map>
+#include <utility> // std::exchange
+#include <vector>
 
 #include <meevax/memory/collector.hpp>
 
@@ -11,14 +19,45 @@ inline namespace memory
   {
     if (not reference_count++)
     {
-      objects = {};
+      young.clear();
 
-      regions = {};
+      remembered.clear();
+
+      state = cycle::idle;
+
+      budget = std::chrono::microseconds(0);
+
+      threads = std::min<std::size_t>(std::max<std::size_t>(std::thread::hardware_concurrency(), 1), 8);
+
+      gray_limit = mark_stack_limit_default;
+
+      heap = {};
+
+      cursor = {};
+
+      tail = {};
+
+      old_size = 0;
+
+      old_limit = 64_MiB;
+
+      size = 0;
+
+      occupancy = 0;
 
       allocation = 0;
 
-      // threshold = std::numeric_limits<std::size_t>::max();
-      threshold = 8_MiB;
+      growth = 2;
+
+      threshold_min = 16_MiB;
+
+      threshold_max = 1_GiB;
+
+      threshold = threshold_min;
+
+      limit = std::numeric_limits<std::size_t>::max();
+
+      overdrawn = false;
     }
   }
 
@@ -36,10 +75,1487 @@ inline namespace memory
       collect();
       collect(); // XXX: vector elements
 
-      assert(std::size(objects) == 0);
-      assert(std::size(regions) == 0);
+      assert(size == 0);
+
+      for (auto & list : heap)
+      {
+        while (list)
+        {
+          deallocate_page(std::exchange(list, list->next));
+        }
+      }
+
+      pages.clear();
+
+      for (auto const& [bytes, data] : std::exchange(vacancies, {}))
+      {
+        ::munmap(data, bytes);
+      }
+
+      vacant = 0;
+
+      spares = {};
+    }
+  }
+
+  void collector::sweep()
+  {
+    prepare_sweep();
+
+    sweep(std::chrono::steady_clock::time_point::max());
+  }
+
+  void collector::sweep(pointer<page> const p)
+  {
+    p->for_each([&](auto && region)
+    {
+      if (not region->marked())
+      {
+        if (not region->assigned())
+        {
+          region->mark();
+        }
+        else if (region->finalized_lazily())
+        {
+          finalizable.push_back(region);
+          pending += region->bytes();
+        }
+        else
+        {
+          deallocate(p, region);
+        }
+      }
+      else if (region->assigned())
+      {
+        region->promote();
+        old_size += region->bytes();
+      }
+    });
+  }
+
+  auto collector::sweep(std::chrono::steady_clock::time_point const deadline, std::size_t pages) -> bool
+  {
+    while (sweeping < std::size(heap))
+    {
+      if (auto const p = *sweeping_link; p)
+      {
+        if (not pages-- or deadline < std::chrono::steady_clock::now())
+        {
+          return false;
+        }
+
+        sweep(p);
+
+        if (p->empty())
+        {
+          *sweeping_link = p->next;
+
+          if (sweeping < large)
+          {
+            if (cursor[sweeping] == p)
+            {
+              cursor[sweeping] = p->next;
+            }
+
+            if (tail[sweeping] == p)
+            {
+              tail[sweeping] = sweeping_last;
+            }
+          }
+
+          deallocate_page(p);
+        }
+        else
+        {
+          sweeping_last = p;
+          sweeping_link = &p->next;
+        }
+      }
+      else
+      {
+        if (sweeping < large)
+        {
+          cursor[sweeping] = heap[sweeping];
+          tail[sweeping] = sweeping_last;
+        }
+
+        if (++sweeping < std::size(heap))
+        {
+          sweeping_link = &heap[sweeping];
+          sweeping_last = nullptr;
+        }
+      }
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  The next major collection runs when the old generation has grown by
+     *  the growth factor, so the amortized cost of major collections stays
+     *  proportional to the allocation rate.
+     *
+     * ---------------------------------------------------------------------- */
+    old_limit = std::max<std::size_t>(old_size, 32_MiB) * growth;
+
+    state = cycle::idle;
+
+    return true;
+  }
+
+  void collector::prepare_sweep()
+  {
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Every assigned region that survives is promoted, and the young list
+     *  must not refer to pages released by sweeping, so only the objects under
+     *  construction are kept in it. For the same reason the remembered set is
+     *  emptied: everything it could refer to is about to become old.
+     *
+     * ---------------------------------------------------------------------- */
+    young.remove_if([](auto && r)
+    {
+      return not r->allocated() or r->assigned();
+    });
+
+    for (auto region : remembered)
+    {
+      region->forget();
+    }
+
+    remembered.clear();
+
+    spares = {};
+
+    ++epoch; // the pages of open arenas may be released
+
+    old_size = 0;
+
+    sweeping = 0;
+    sweeping_link = &heap[0];
+    sweeping_last = nullptr;
+
+    state = cycle::sweeping;
+  }
+
+  void collector::start()
+  {
+    finalize();
+
+    marker::toggle();
+
+    gray.clear();
+
+    overflowed = false;
+
+    shade_roots();
+
+    state = cycle::marking;
+
+    step_at = allocation + step_size;
+  }
+
+  void collector::remark()
+  {
+    shade_roots();
+
+    drain(std::chrono::steady_clock::time_point::max());
+
+    while (overflowed)
+    {
+      rescan();
+    }
+
+    settle(rescan);
+
+    prepare_sweep();
+  }
+
+  void collector::mark()
+  {
+    finalize();
+
+    marker::toggle();
+
+    if (1 < threads and parallel_threshold < size)
+    {
+      mark_in_parallel();
+    }
+    else
+    {
+      shade_roots();
+
+      drain(std::chrono::steady_clock::time_point::max());
+
+      while (overflowed)
+      {
+        rescan();
+      }
+    }
+
+    settle(rescan);
+  }
+
+  void collector::mark_young()
+  {
+    finalize();
+
+    for (auto r : young)
+    {
+      if (r->allocated() and r->young())
+      {
+        r->unmark();
+      }
+    }
+
+    for (auto r : remembered)
+    {
+      if (r->allocated())
+      {
+        trace(r, shade);
+      }
+    }
+
+    shade_roots();
+
+    drain(std::chrono::steady_clock::time_point::max());
+
+    while (overflowed)
+    {
+      rescan_young();
+    }
+
+    settle(rescan_young);
+  }
+
+  void collector::rescan()
+  {
+    overflowed = false;
+
+    for_each_page([](auto && p)
+    {
+      p->for_each([](auto && r)
+      {
+        if (r->marked())
+        {
+          trace(r, shade);
+          drain(std::chrono::steady_clock::time_point::max());
+        }
+      });
+    });
+  }
+
+  void collector::rescan_young()
+  {
+    overflowed = false;
+
+    for (auto r : young)
+    {
+      if (r->allocated() and r->young() and r->marked())
+      {
+        trace(r, shade);
+        drain(std::chrono::steady_clock::time_point::max());
+      }
+    }
+  }
+
+  void collector::settle(void (*rescan)())
+  {
+    auto alive = [](pointer<void> const x)
+    {
+      auto const r = region_of(x);
+      return not r or r->marked();
+    };
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Old regions stay marked between major collections, so the same
+     *  fixpoint serves minor collections, which only ever shade young data
+     *  here.
+     *
+     * ---------------------------------------------------------------------- */
+    for (auto shaded = true; shaded; )
+    {
+      shaded = false;
+
+      for_each_ephemeron([&](auto && e)
+      {
+        if (not e->b and alive(e->k) and not alive(e->d))
+        {
+          shade(region_of(e->d));
+          shaded = true;
+        }
+      });
+
+      drain(std::chrono::steady_clock::time_point::max());
+
+      while (overflowed)
+      {
+        rescan();
+      }
+    }
+
+    for_each_ephemeron([&](auto && e)
+    {
+      if (not e->b and not alive(e->k))
+      {
+        e->k = nullptr;
+        e->d = nullptr;
+        e->b = true;
+      }
+    });
+  }
+
+  void collector::shade_concurrently(pointer<region> const the_region)
+  {
+    if (stopped)
+    {
+      shade(the_region);
+    }
+    else if (the_region and the_region->try_mark())
+    {
+      record(&buffer::gray, gray, the_region);
+    }
+  }
+
+  void collector::record(std::vector<pointer<region>> buffer::* const local_list, registry<pointer<region>> & list, pointer<region> const r)
+  {
+    if (stopped)
+    {
+      list.push_back(r);
+    }
+    else if (auto const b = local; b)
+    {
+      (b->*local_list).push_back(r);
+    }
+    else
+    {
+      exclusively([&] { list.push_back(r); });
+    }
+  }
+
+  void collector::shade_roots()
+  {
+    for (auto r : young)
+    {
+      if (r->allocated() and not r->assigned())
+      {
+        shade(r);
+      }
+    }
+
+    for_each_root_cell([](auto && root)
+    {
+      shade(region_of(root->target()));
+    });
+  }
+
+  auto collector::drain(std::chrono::steady_clock::time_point const deadline) -> bool
+  {
+    for (std::size_t n = 1; not gray.empty(); ++n)
+    {
+      if (n % 64 == 0 and deadline < std::chrono::steady_clock::now())
+      {
+        return false;
+      }
+
+      auto const r = gray.back();
+
+      gray.pop_back();
+
+      if (r->allocated())
+      {
+        trace(r, shade);
+      }
+    }
+
+    return true;
+  }
+
+  void collector::step()
+  {
+    auto const _ = pause();
+
+    auto const deadline = std::chrono::steady_clock::now() + budget;
+
+    if (state == cycle::marking and measure(cycle_mark_time, [&] { return drain(deadline); }))
+    {
+      measure(cycle_mark_time, remark);
+    }
+
+    if (state == cycle::sweeping and measure(cycle_sweep_time, [&] { return sweep(deadline); }))
+    {
+      record(cumulative.major_collections);
+
+      allocation = 0;
+    }
+    else if (threshold < allocation / 2)
+    {
+      /* ---- NOTE -------------------------------------------------------------
+       *
+       *  The mutator is allocating faster than the slices can reclaim, so the
+       *  rest of the cycle runs at once rather than letting the heap grow
+       *  without bound.
+       *
+       * -------------------------------------------------------------------- */
+      finish();
+
+      allocation = 0;
+    }
+
+    step_at = allocation + step_size;
+  }
+
+  void collector::finish()
+  {
+    if (state == cycle::marking)
+    {
+      measure(cycle_mark_time, remark);
+    }
+
+    if (state == cycle::sweeping)
+    {
+      measure(cycle_sweep_time, [] { sweep(std::chrono::steady_clock::time_point::max()); });
+
+      record(cumulative.major_collections);
+    }
+  }
+
+  void collector::mark_in_parallel()
+  {
+    struct worker
+    {
+      std::vector<pointer<region>> local;
+
+      std::mutex mutex;
+
+      std::deque<pointer<region>> shared;
+    };
+
+    auto const workers = std::make_unique<worker[]>(threads);
+
+    std::size_t n = 0;
+
+    auto seed = [&](pointer<region> const r)
+    {
+      if (r and r->try_mark())
+      {
+        workers[n++ % threads].local.push_back(r);
+      }
+    };
+
+    for (auto r : young)
+    {
+      if (r->allocated() and not r->assigned())
+      {
+        seed(r);
+      }
+    }
+
+    for_each_root_cell([&](auto && root)
+    {
+      seed(region_of(root->target()));
+    });
+
+    std::atomic<std::size_t> idle = 0;
+
+    auto steal = [&](std::size_t const thief)
+    {
+      for (std::size_t k = 1; k < threads; ++k)
+      {
+        auto & victim = workers[(thief + k) % threads];
+
+        if (auto const lock = std::unique_lock(victim.mutex); not victim.shared.empty())
+        {
+          auto const half = (std::size(victim.shared) + 1) / 2;
+          auto & local = workers[thief].local;
+          local.insert(std::end(local), std::begin(victim.shared), std::next(std::begin(victim.shared), half));
+          victim.shared.erase(std::begin(victim.shared), std::next(std::begin(victim.shared), half));
+          return true;
+        }
+      }
+
+      return false;
+    };
+
+    auto work = [&](std::size_t const id)
+    {
+      auto & self = workers[id];
+
+      for (;;)
+      {
+        while (not self.local.empty())
+        {
+          auto const r = self.local.back();
+
+          self.local.pop_back();
+
+          trace(r, [&](auto && child)
+          {
+            if (child and child->try_mark())
+            {
+              self.local.push_back(child);
+            }
+          });
+
+          if (1 < std::size(self.local))
+          {
+            if (auto const lock = std::unique_lock(self.mutex); self.shared.empty())
+            {
+              auto const half = std::size(self.local) / 2;
+              self.shared.insert(std::end(self.shared), std::begin(self.local), std::next(std::begin(self.local), half));
+              self.local.erase(std::begin(self.local), std::next(std::begin(self.local), half));
+            }
+          }
+        }
+
+        if (auto const lock = std::unique_lock(self.mutex); not self.shared.empty())
+        {
+          self.local.assign(std::begin(self.shared), std::end(self.shared));
+          self.shared.clear();
+          continue;
+        }
+
+        ++idle;
+
+        while (not steal(id))
+        {
+          if (idle == threads)
+          {
+            return;
+          }
+
+          std::this_thread::yield();
+        }
+
+        --idle;
+      }
+    };
+
+    std::vector<std::thread> helpers;
+
+    for (std::size_t id = 1; id < threads; ++id)
+    {
+      helpers.emplace_back(work, id);
+    }
+
+    work(0);
+
+    for (auto & helper : helpers)
+    {
+      helper.join();
+    }
+  }
+
+  void collector::sweep_young()
+  {
+    auto large_freed = false;
+
+    young.remove_if([&](auto && region)
+    {
+      if (not region->allocated() or not region->young())
+      {
+        return true; // released by deallocate, or a duplicate of a reused slot
+      }
+      else if (not region->assigned())
+      {
+        return false; // under construction
+      }
+      else if (not region->marked())
+      {
+        if (region->finalized_lazily())
+        {
+          finalizable.push_back(region);
+          pending += region->bytes();
+        }
+        else
+        {
+          large_freed |= size_class_of(region->bytes()) == large;
+          deallocate(pages.find(reinterpret_cast<std::uintptr_t>(region)), region);
+        }
+
+        return true;
+      }
+      else
+      {
+        region->promote();
+        old_size += region->bytes();
+        return true;
+      }
+    });
+
+    for (auto region : remembered)
+    {
+      region->forget();
+    }
+
+    remembered.clear();
+
+    for (std::size_t k = 0; k < large; ++k)
+    {
+      cursor[k] = heap[k];
+    }
+
+    if (large_freed)
+    {
+      release_empty_large_pages();
+    }
+  }
+
+  auto collector::finalize(std::size_t quota) -> bool
+  {
+    auto large_freed = false;
+
+    auto const before = occupancy - released.load(std::memory_order_relaxed);
+
+    auto regions = std::size_t(0);
+
+    for (; quota and not finalizable.empty(); --quota)
+    {
+      auto const r = finalizable.back();
+
+      finalizable.pop_back();
+
+      pending -= r->bytes();
+
+      regions += r->bytes();
+
+      large_freed |= size_class_of(r->bytes()) == large;
+
+      deallocate(pages.find(reinterpret_cast<std::uintptr_t>(r)), r);
     }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  The payloads of the objects in the queue were counted as live by the
+     *  last collection, as the collector does not know their sizes until the
+     *  objects are destroyed. The threshold is lowered by what they freed.
+     *
+     * ---------------------------------------------------------------------- */
+    if (auto const payloads = before - (occupancy - released.load(std::memory_order_relaxed)) - regions; payloads)
+    {
+      cumulative.live_bytes -= std::min(payloads, cumulative.live_bytes);
+      retune();
+    }
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  While a sweep is in progress, sweeping_link may point into the list of
+     *  large pages, so empty large pages are left for the sweep to release.
+     *
+     * ---------------------------------------------------------------------- */
+    if (large_freed and state != cycle::sweeping)
+    {
+      release_empty_large_pages();
+    }
+
+    return finalizable.empty();
+  }
+
+  void collector::major()
+  {
+    auto const _ = pause();
+
+    world const stopped;
+
+    finish();
+
+    measure(cycle_mark_time, [this] { mark(); });
+
+    prepare_sweep();
+
+    allocation = 0;
+  }
+
+  void collector::minor()
+  {
+    auto const _ = pause();
+
+    world const stopped;
+
+    if (state != cycle::idle)
+    {
+      finish();
+    }
+    else
+    {
+      measure(cycle_mark_time, [this] { mark_young(); });
+
+      measure(cycle_sweep_time, [this] { sweep_young(); });
+
+      record(cumulative.minor_collections);
+    }
+
+    allocation = 0;
+  }
+
+  void collector::open_arena()
+  {
+    if (auto const lock = acquire(); lock)
+    {
+      if (local)
+      {
+        retire(*local);
+      }
+
+      current = new arena { {}, epoch, current };
+    }
+  }
+
+  void collector::close_arena()
+  {
+    if (auto const lock = acquire(); lock)
+    {
+      if (not current)
+      {
+        return;
+      }
+
+      auto const a = std::unique_ptr<arena>(std::exchange(current, current->outer));
+
+      if (state == cycle::idle)
+      {
+        auto const _ = pause();
+
+        world const stopped;
+
+        measure(cycle_mark_time, [] { gc.mark_young(); });
+
+        measure(cycle_sweep_time, [&]
+        {
+          if (a->epoch == epoch)
+          {
+            reclaim(*a);
+          }
+
+          gc.sweep_young();
+        });
+
+        record(cumulative.minor_collections);
+
+        allocation = 0;
+      }
+    }
+  }
+
+  auto collector::acquire_empty_page(std::size_t const k) -> pointer<page>
+  {
+    auto p = pointer<page>(nullptr);
+
+    while (not p and not spares[k].empty())
+    {
+      if (p = spares[k].back(); spares[k].pop_back(), not p->empty() or p->owned)
+      {
+        p = nullptr; // allocated from since it was emptied
+      }
+    }
+
+    if (not p)
+    {
+      p = allocate_page(size_classes[k], page::capacity_of(size_classes[k]));
+
+      (tail[k] ? tail[k]->next : heap[k]) = p;
+      tail[k] = p;
+
+      if (not cursor[k])
+      {
+        cursor[k] = p;
+      }
+    }
+
+    adopt(k, p);
+
+    return p;
+  }
+
+  void collector::adopt(std::size_t const k, pointer<page> const p)
+  {
+    if (current->epoch != epoch)
+    {
+      current->pages = {};
+      current->epoch = epoch;
+    }
+
+    current->pages[k].push_back(p);
+  }
+
+  void collector::reclaim(arena & a)
+  {
+    std::unordered_map<pointer<page>, std::size_t> doomed; // pages to empty, and their size classes
+
+    for (std::size_t k = 0; k < std::size(a.pages); ++k)
+    {
+      for (auto p : a.pages[k])
+      {
+        auto bytes = std::size_t(0);
+
+        auto count = std::size_t(0);
+
+        auto escaped = false;
+
+        p->for_each([&](auto && r)
+        {
+          if (r->young() and r->assigned() and not r->marked() and not r->finalized_lazily())
+          {
+            bytes += r->bytes();
+            ++count;
+          }
+          else
+          {
+            escaped = true;
+          }
+        });
+
+        if (not escaped and doomed.emplace(p, k).second)
+        {
+          occupancy -= bytes;
+          size -= count;
+        }
+      }
+    }
+
+    if (doomed.empty())
+    {
+      return;
+    }
+
+    frees.store(frees.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    young.remove_if([&](auto && region)
+    {
+      return doomed.count(pages.find(reinterpret_cast<std::uintptr_t>(region)));
+    });
+
+    auto large_freed = false;
+
+    for (auto [p, k] : doomed)
+    {
+      p->reset();
+
+      if (k < large)
+      {
+        spares[k].push_back(p);
+      }
+      else
+      {
+        large_freed = true;
+      }
+    }
+
+    if (large_freed)
+    {
+      release_empty_large_pages();
+    }
+  }
+
+  void collector::release_empty_large_pages()
+  {
+    for (auto link = &heap[large]; *link; )
+    {
+      if (auto const p = *link; p->empty())
+      {
+        *link = p->next;
+        deallocate_page(p);
+      }
+      else
+      {
+        link = &p->next;
+      }
+    }
+  }
+
+  collector::world::world()
+  {
+    if (not stopped++)
+    {
+      for (auto b : buffers)
+      {
+        if (b != local)
+        {
+          locks.emplace_back(b->mutex);
+        }
+      }
+    }
+
+    for (auto b : buffers)
+    {
+      retire(*b);
+    }
+  }
+
+  collector::world::~world()
+  {
+    --stopped;
+  }
+
+  static thread_local bool detached = false;
+
+  auto collector::attach() -> pointer<buffer>
+  {
+    if (detached)
+    {
+      return nullptr; // the thread is exiting
+    }
+    else if (auto const lock = std::unique_lock(resource); lock)
+    {
+      static thread_local struct reaper
+      {
+        ~reaper()
+        {
+          detach();
+        }
+      } const reaper;
+
+      static_cast<void>(reaper);
+
+      if (not std::empty(buffers) and not page::shared.load(std::memory_order_relaxed))
+      {
+        world const stopped; // no other thread is between reading page::shared and setting a bit
+
+        page::shared.store(true, std::memory_order_relaxed);
+      }
+
+      buffers.push_back(local = new buffer());
+
+      if (auto const t = std::find(std::next(std::begin(taken)), std::end(taken), false); t != std::end(taken))
+      {
+        *t = true;
+        own = std::distance(std::begin(taken), t);
+      }
+
+      return local;
+    }
+    else
+    {
+      return nullptr;
+    }
+  }
+
+  void collector::detach()
+  {
+    if (auto const b = local; b)
+    {
+      if (b->hold.owns_lock())
+      {
+        b->hold.unlock();
+      }
+
+      if (auto const lock = std::unique_lock(resource); lock)
+      {
+        retire(*b);
+        buffers.erase(b);
+        local = nullptr;
+
+        if (auto const t = std::exchange(own, 0); t)
+        {
+          /*
+           *  The entries left in the table of the thread, typically the cells
+           *  of its thread_local and static objects, move to the shared table.
+           */
+          auto move = [&](auto & from, auto & to)
+          {
+            using index_type = std::remove_reference_t<decltype(from[0]->index)>;
+
+            for (auto x : from)
+            {
+              x->index = static_cast<index_type>(to.push_back(x));
+            }
+
+            from.clear();
+          };
+
+          move(tables[t].roots, tables[0].roots);
+          move(tables[t].ephemerons, tables[0].ephemerons);
+
+          taken[t] = false;
+        }
+      }
+
+      delete b;
+    }
+
+    detached = true;
+  }
+
+  template <typename T>
+  void collector::enroll_slowly(registry<T *> table::* const list, T * const x)
+  {
+    using index_type = decltype(x->index);
+
+    auto push = [&](std::size_t const t)
+    {
+      if (auto & entries = tables[t].*list; std::size(entries) < (index_type(1) << slot_bits<index_type>) - 1)
+      {
+        x->index = static_cast<index_type>(t) << slot_bits<index_type> | static_cast<index_type>(entries.push_back(x));
+      }
+      else
+      {
+        throw std::bad_alloc();
+      }
+    };
+
+    if (not local)
+    {
+      attach();
+    }
+
+    if (own)
+    {
+      push(own);
+    }
+    else
+    {
+      exclusively([&] { push(0); });
+    }
+  }
+
+  template void collector::enroll_slowly(registry<object *> table::* const, object * const);
+
+  template void collector::enroll_slowly(registry<ephemeron *> table::* const, ephemeron * const);
+
+  template <typename T>
+  void collector::withdraw_slowly(registry<T *> table::* const list, T * const x) noexcept
+  {
+    using index_type = decltype(x->index);
+
+    exclusively([&]
+    {
+      remove(tables[x->index >> slot_bits<index_type>].*list, x);
+    });
+  }
+
+  template void collector::withdraw_slowly(registry<object *> table::* const, object * const) noexcept;
+
+  template void collector::withdraw_slowly(registry<ephemeron *> table::* const, ephemeron * const) noexcept;
+
+  void collector::flush(buffer & b)
+  {
+    for (auto r : b.young)
+    {
+      young.push_back(r);
+    }
+
+    b.young.clear();
+
+    for (auto r : b.remembered)
+    {
+      remembered.push_back(r);
+    }
+
+    b.remembered.clear();
+
+    for (auto r : b.gray)
+    {
+      push_gray(r);
+    }
+
+    b.gray.clear();
+
+    size += b.objects;
+
+    allocation -= b.reserve;
+
+    occupancy -= b.reserve;
+
+    cumulative.allocated_bytes += b.granted - b.reserve;
+
+    cumulative.allocated_objects += b.objects;
+
+    b.reserve = b.granted = b.objects = 0;
+  }
+
+  auto collector::refill(std::size_t const size) -> pointer<void>
+  {
+    auto const b = local ? local : attach();
+
+    auto const yielded = b and b->hold.owns_lock();
+
+    if (yielded)
+    {
+      b->hold.unlock();
+    }
+
+    if (auto const lock = std::unique_lock(resource); lock)
+    {
+      if (yielded)
+      {
+        b->hold.lock();
+      }
+
+      if (b)
+      {
+        flush(*b);
+      }
+
+      occupancy -= released.exchange(0, std::memory_order_relaxed);
+
+      auto const n = std::max<std::size_t>(size, 1);
+
+      auto const k = size_class_of(n);
+
+      auto const buffered = b and k < large and occupancy + buffer_size < limit;
+
+      auto const grant = buffered ? buffer_size : n;
+
+      make_room(grant);
+
+      if (buffered)
+      {
+        if (auto & p = b->pages[k]; not p or p->full())
+        {
+          if (p)
+          {
+            p->owned = false;
+          }
+
+          p = acquire_page(k);
+          p->owned = true;
+        }
+
+        b->reserve = b->granted = grant;
+
+        allocation += grant;
+
+        occupancy += grant;
+
+        auto const r = b->pages[k]->allocate(n);
+
+        b->reserve -= r->bytes();
+        b->young.push_back(r);
+        ++b->objects;
+
+        return reinterpret_cast<pointer<void>>(r->lower_bound());
+      }
+      else
+      {
+        allocation += n;
+
+        auto const r = allocate_region(n);
+
+        young.push_back(r);
+
+        ++collector::size;
+
+        occupancy += r->bytes();
+
+        cumulative.allocated_bytes += r->bytes();
+
+        ++cumulative.allocated_objects;
+
+        return reinterpret_cast<pointer<void>>(r->lower_bound());
+      }
+    }
+    else
+    {
+      throw std::bad_alloc();
+    }
+  }
+
+  void collector::make_room(std::size_t const grant)
+  {
+    if (state != cycle::idle and budget.count())
+    {
+      if (step_at <= allocation)
+      {
+        world const stopped;
+        step();
+      }
+    }
+    else
+    {
+      if (state == cycle::sweeping or not finalizable.empty())
+      {
+        auto const _ = pause();
+
+        world const stopped;
+
+        if (state == cycle::sweeping)
+        {
+          if (overflow())
+          {
+            finish();
+          }
+          else if (measure(cycle_sweep_time, [] { return sweep(std::chrono::steady_clock::time_point::max(), lazy_sweep_pages); }))
+          {
+            record(cumulative.major_collections);
+          }
+        }
+
+        finalize(overflow() ? std::numeric_limits<std::size_t>::max() : finalization_quota);
+      }
+
+      if (state == cycle::idle and overflow())
+      {
+        if (not (old_limit < old_size))
+        {
+          minor();
+        }
+        else if (budget.count())
+        {
+          world const stopped;
+          start();
+        }
+        else
+        {
+          major();
+        }
+      }
+    }
+
+    if (limit < occupancy + grant and not overdrawn)
+    {
+      collect();
+
+      if (overdrawn = limit - limit / 8 < occupancy + grant; overdrawn)
+      {
+        interrupt(heap_exhaustion);
+      }
+    }
+
+    if (limit < occupancy + grant and limit / 8 < occupancy + grant - limit)
+    {
+      throw heap_exhausted();
+    }
+  }
+
+  auto collector::allocate_payload(std::size_t const size) -> pointer<void>
+  {
+    if (size < large_payload)
+    {
+      if (auto const b = local; b and size < b->reserve)
+      {
+        b->reserve -= size;
+      }
+      else if (auto const lock = acquire(); lock)
+      {
+        gc.make_room(size);
+
+        allocation += size;
+
+        occupancy += size;
+
+        cumulative.allocated_bytes += size;
+      }
+
+      return ::operator new(size);
+    }
+    else if (auto const lock = acquire(); lock)
+    {
+      auto const extent = (size + page_size - 1) / page_size * page_size;
+
+      gc.make_room(extent);
+
+      pointer<void> data = nullptr;
+
+      auto bytes = extent;
+
+      /* ---- NOTE -------------------------------------------------------------
+       *
+       *  A vacancy is reused for a payload if it wastes less than a quarter of
+       *  it, so that a payload that is freed and allocated again in a loop
+       *  (e.g. make-vector of the same length) never maps new pages.
+       *
+       * -------------------------------------------------------------------- */
+      if (auto const iter = vacancies.lower_bound(extent); iter != std::end(vacancies) and iter->first - extent <= iter->first / 4)
+      {
+        bytes = iter->first;
+        data = iter->second;
+        vacancies.erase(iter);
+        vacant -= bytes;
+      }
+      else if (data = ::mmap(nullptr, extent, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0); data == MAP_FAILED)
+      {
+        throw std::bad_alloc();
+      }
+
+      extents.emplace(data, bytes);
+
+      allocation += bytes;
+
+      occupancy += bytes;
+
+      cumulative.allocated_bytes += bytes;
+
+      cumulative.large_object_bytes += bytes;
+
+      return data;
+    }
+    else
+    {
+      throw std::bad_alloc();
+    }
+  }
+
+  void collector::deallocate_payload(pointer<void> const data, std::size_t const size) noexcept
+  {
+    if (size < large_payload)
+    {
+      ::operator delete(data);
+      released.fetch_add(size, std::memory_order_relaxed);
+    }
+    else if (auto const lock = acquire(); lock)
+    {
+      if (auto const iter = extents.find(data); iter != std::end(extents))
+      {
+        auto const bytes = iter->second;
+
+        extents.erase(iter);
+
+        occupancy -= bytes;
+
+        cumulative.large_object_bytes -= bytes;
+
+        if (vacant + bytes <= vacancy_max)
+        {
+          ::madvise(data, bytes, MADV_DONTNEED);
+          vacancies.emplace(bytes, data);
+          vacant += bytes;
+        }
+        else
+        {
+          ::munmap(data, bytes);
+        }
+      }
+    }
+  }
+
+  void collector::retire(buffer & b)
+  {
+    for (auto & p : b.pages)
+    {
+      if (p)
+      {
+        p->owned = false;
+        p = nullptr;
+      }
+    }
+
+    flush(b);
+  }
+
+  #ifdef MEEVAX_COMPRESSED_REFERENCES
+  auto collector::allocate_page(std::size_t const slot_size, std::size_t const capacity) -> pointer<page>
+  {
+    if (not heap_base)
+    {
+      auto const data = ::mmap(nullptr, reservation_size + page_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+      if (data == MAP_FAILED)
+      {
+        throw std::bad_alloc();
+      }
+
+      auto const lower = reinterpret_cast<std::uintptr_t>(data);
+      auto const aligned = (lower + page_size - 1) / page_size * page_size;
+
+      if (lower < aligned)
+      {
+        ::munmap(data, aligned - lower);
+      }
+
+      ::munmap(reinterpret_cast<pointer<void>>(aligned + reservation_size), lower + page_size - aligned);
+
+      heap_base = aligned;
+    }
+
+    auto const extent = page::extent_of(slot_size, capacity);
+
+    auto address = std::uintptr_t(0);
+
+    if (auto const iter = fits.lower_bound({ extent, 0 }); iter != std::end(fits))
+    {
+      auto const [bytes, hole] = *iter;
+
+      fits.erase(iter);
+      holes.erase(hole);
+
+      if (extent < bytes)
+      {
+        holes.emplace(hole + extent, bytes - extent);
+        fits.emplace(bytes - extent, hole + extent);
+      }
+
+      address = hole;
+    }
+    else if (reserved + extent <= reservation_size)
+    {
+      address = heap_base + std::exchange(reserved, reserved + extent);
+
+      if (::mprotect(reinterpret_cast<pointer<void>>(address), extent, PROT_READ | PROT_WRITE))
+      {
+        reserved -= extent;
+        throw std::bad_alloc();
+      }
+    }
+    else
+    {
+      throw std::bad_alloc();
+    }
+
+    auto const p = new (reinterpret_cast<pointer<void>>(address)) page(slot_size, capacity);
+    pages.insert(p);
+    return p;
+  }
+
+  void collector::deallocate_page(pointer<page> const p)
+  {
+    auto const extent = p->extent();
+    pages.erase(p);
+    p->~page();
+    ::madvise(p, extent, MADV_DONTNEED);
+
+    auto lower = reinterpret_cast<std::uintptr_t>(p);
+
+    auto bytes = extent;
+
+    if (auto const next = holes.find(lower + bytes); next != std::end(holes))
+    {
+      bytes += next->second;
+      fits.erase({ next->second, next->first });
+      holes.erase(next);
+    }
+
+    if (auto const next = holes.lower_bound(lower); next != std::begin(holes))
+    {
+      if (auto const prev = std::prev(next); prev->first + prev->second == lower)
+      {
+        lower = prev->first;
+        bytes += prev->second;
+        fits.erase({ prev->second, prev->first });
+        holes.erase(prev);
+      }
+    }
+
+    if (lower + bytes == heap_base + reserved)
+    {
+      reserved -= bytes;
+    }
+    else
+    {
+      holes.emplace(lower, bytes);
+      fits.emplace(bytes, lower);
+    }
+  }
+  #else
+  auto collector::allocate_page(std::size_t const slot_size, std::size_t const capacity) -> pointer<page>
+  {
+    if (auto const data = std::aligned_alloc(page_size, page::extent_of(slot_size, capacity)); data)
+    {
+      auto const p = new (data) page(slot_size, capacity);
+      pages.insert(p);
+      return p;
+    }
+    else
+    {
+      throw std::bad_alloc();
+    }
+  }
+
+  void collector::deallocate_page(pointer<page> const p)
+  {
+    pages.erase(p);
+    p->~page();
+    std::free(p);
   }
+  #endif
 } // namespace memory
 } // namespace meevax
 
@@ -0,0 +1,441 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include <meevax/memory/snapshot.hpp>
+
+namespace meevax
+{
+inline namespace memory
+{
+  namespace
+  {
+    struct json_reader
+    {
+      std::istream & is;
+
+      auto peek() -> char
+      {
+        return (is >> std::ws).peek();
+      }
+
+      void expect(char const c)
+      {
+        if (peek() != c)
+        {
+          throw std::runtime_error(std::string("heap snapshot: expected '") + c + "'");
+        }
+
+        is.get();
+      }
+
+      auto string() -> std::string
+      {
+        expect('"');
+
+        std::string result;
+
+        for (auto c = is.get(); c != '"'; c = is.get())
+        {
+          if (c == std::char_traits<char>::eof())
+          {
+            throw std::runtime_error("heap snapshot: unterminated string");
+          }
+          else if (c == '\\')
+          {
+            c = is.get();
+          }
+
+          result.push_back(c);
+        }
+
+        return result;
+      }
+
+      auto number() -> std::size_t
+      {
+        std::size_t result = 0;
+
+        if (peek(); not (is >> result))
+        {
+          throw std::runtime_error("heap snapshot: expected a number");
+        }
+
+        return result;
+      }
+
+      template <typename F>
+      void sequence(char const open, char const close, F&& f)
+      {
+        expect(open);
+
+        if (peek() == close)
+        {
+          is.get();
+          return;
+        }
+
+        for (f(); peek() == ','; f())
+        {
+          is.get();
+        }
+
+        expect(close);
+      }
+    };
+
+    void write_string(std::ostream & os, std::string const& s)
+    {
+      os << '"';
+
+      for (auto c : s)
+      {
+        if (c == '"' or c == '\\')
+        {
+          os << '\\';
+        }
+
+        os << c;
+      }
+
+      os << '"';
+    }
+  } // namespace
+
+  auto snapshot::read(std::istream & is) -> snapshot
+  {
+    snapshot result;
+
+    json_reader reader { is };
+
+    reader.sequence('{', '}', [&]()
+    {
+      auto const key = reader.string();
+
+      reader.expect(':');
+
+      if (key == "format")
+      {
+        if (reader.string() != "meevax-heap-snapshot")
+        {
+          throw std::runtime_error("heap snapshot: unknown format");
+        }
+      }
+      else if (key == "version")
+      {
+        if (reader.number() != 1)
+        {
+          throw std::runtime_error("heap snapshot: unknown version");
+        }
+      }
+      else if (key == "types")
+      {
+        reader.sequence('[', ']', [&]()
+        {
+          result.types.push_back(reader.string());
+        });
+      }
+      else if (key == "objects")
+      {
+        reader.sequence('[', ']', [&]()
+        {
+          object x;
+
+          reader.expect('[');
+          x.type = reader.number();
+          reader.expect(',');
+          x.size = reader.number();
+          reader.expect(',');
+          reader.sequence('[', ']', [&]()
+          {
+            x.edges.push_back(reader.number());
+          });
+          reader.expect(']');
+
+          result.objects.push_back(std::move(x));
+        });
+      }
+      else if (key == "roots")
+      {
+        reader.sequence('[', ']', [&]()
+        {
+          result.roots.push_back(reader.number());
+        });
+      }
+      else
+      {
+        throw std::runtime_error("heap snapshot: unknown key " + key);
+      }
+    });
+
+    auto const n = std::size(result.objects);
+
+    for (auto const& x : result.objects)
+    {
+      if (std::size(result.types) <= x.type or std::any_of(std::begin(x.edges), std::end(x.edges), [&](auto id) { return n <= id; }))
+      {
+        throw std::runtime_error("heap snapshot: index out of range");
+      }
+    }
+
+    if (std::any_of(std::begin(result.roots), std::end(result.roots), [&](auto id) { return n <= id; }))
+    {
+      throw std::runtime_error("heap snapshot: index out of range");
+    }
+
+    return result;
+  }
+
+  auto snapshot::write(std::ostream & os) const -> std::ostream &
+  {
+    os << "{\"format\":\"meevax-heap-snapshot\",\"version\":1,\n\"types\":[";
+
+    for (std::size_t i = 0; i < std::size(types); ++i)
+    {
+      os << (i ? ",\n" : "\n");
+      write_string(os, types[i]);
+    }
+
+    os << "],\n\"objects\":[";
+
+    for (std::size_t i = 0; i < std::size(objects); ++i)
+    {
+      os << (i ? ",\n[" : "\n[") << objects[i].type << "," << objects[i].size << ",[";
+
+      for (std::size_t j = 0; j < std::size(objects[i].edges); ++j)
+      {
+        os << (j ? "," : "") << objects[i].edges[j];
+      }
+
+      os << "]]";
+    }
+
+    os << "],\n\"roots\":[";
+
+    for (std::size_t i = 0; i < std::size(roots); ++i)
+    {
+      os << (i ? "," : "") << roots[i];
+    }
+
+    return os << "]}\n";
+  }
+
+  auto snapshot::dominators() const -> std::vector<std::size_t>
+  {
+    auto const n = std::size(objects);
+
+    auto const root = n, unreachable = n + 1;
+
+    auto successors = [&](std::size_t const v) -> auto const&
+    {
+      return v == root ? roots : objects[v].edges;
+    };
+
+    /* ---- NOTE ---------------------------------------------------------------
+     *
+     *  Depth-first search from the virtual root with an explicit stack, as the
+     *  heap may be deeper than the C++ stack (e.g. a long list).
+     *
+     * ---------------------------------------------------------------------- */
+    std::vector<std::size_t> postorder(n + 1, unreachable);
+
+    std::vector<std::size_t> order; // nodes in postorder
+
+    order.reserve(n + 1);
+
+    std::vector<bool> visited(n + 1, false);
+
+    std::vector<std::pair<std::size_t, std::size_t>> stack { { root, 0 } };
+
+    visited[root] = true;
+
+    while (not stack.empty())
+    {
+      if (auto & [v, i] = stack.back(); i < std::size(successors(v)))
+      {
+        if (auto const w = successors(v)[i++]; not visited[w])
+        {
+          visited[w] = true;
+          stack.emplace_back(w, 0);
+        }
+      }
+      else
+      {
+        postorder[v] = std::size(order);
+        order.push_back(v);
+        stack.pop_back();
+      }
+    }
+
+    std::vector<std::vector<std::size_t>> predecessors(n + 1);
+
+    for (auto v : order)
+    {
+      for (auto w : successors(v))
+      {
+        predecessors[w].push_back(v);
+      }
+    }
+
+    std::vector<std::size_t> idom(n + 1, unreachable);
+
+    idom[root] = root;
+
+    auto intersect = [&](std::size_t a, std::size_t b)
+    {
+      while (a != b)
+      {
+        while (postorder[a] < postorder[b])
+        {
+          a = idom[a];
+        }
+
+        while (postorder[b] < postorder[a])
+        {
+          b = idom[b];
+        }
+      }
+
+      return a;
+    };
+
+    for (auto changed = true; changed; )
+    {
+      changed = false;
+
+      for (auto v = std::rbegin(order); v != std::rend(order); ++v) // reverse postorder
+      {
+        if (*v == root)
+        {
+          continue;
+        }
+
+        auto dominator = unreachable;
+
+        for (auto p : predecessors[*v])
+        {
+          if (idom[p] != unreachable)
+          {
+            dominator = dominator == unreachable ? p : intersect(p, dominator);
+          }
+        }
+
+        if (idom[*v] != dominator)
+        {
+          idom[*v] = dominator;
+          changed = true;
+        }
+      }
+    }
+
+    idom.pop_back(); // the virtual root
+
+    return idom;
+  }
+
+  auto snapshot::retained_sizes(std::vector<std::size_t> const& idom) const -> std::vector<std::size_t>
+  {
+    auto const n = std::size(objects);
+
+    std::vector<std::size_t> retained(n + 1, 0);
+
+    std::vector<std::vector<std::size_t>> children(n + 1);
+
+    for (std::size_t v = 0; v < n; ++v)
+    {
+      retained[v] = objects[v].size;
+
+      if (idom[v] <= n)
+      {
+        children[idom[v]].push_back(v);
+      }
+    }
+
+    std::vector<std::pair<std::size_t, bool>> stack { { n, false } };
+
+    while (not stack.empty())
+    {
+      if (auto const [v, visited] = stack.back(); visited)
+      {
+        stack.pop_back();
+
+        if (v < n)
+        {
+          retained[idom[v]] += retained[v];
+        }
+      }
+      else
+      {
+        stack.back().second = true;
+
+        for (auto w : children[v])
+        {
+          stack.emplace_back(w, false);
+        }
+      }
+    }
+
+    retained.pop_back(); // the virtual root
+
+    return retained;
+  }
+
+  auto snapshot::retained_by_type(std::vector<std::size_t> const& idom,
+                                  std::vector<std::size_t> const& retained) const -> std::vector<summary>
+  {
+    auto const n = std::size(objects);
+
+    std::vector<summary> result(std::size(types));
+
+    std::vector<std::vector<std::size_t>> children(n + 1);
+
+    for (std::size_t v = 0; v < n; ++v)
+    {
+      if (idom[v] <= n)
+      {
+        children[idom[v]].push_back(v);
+      }
+    }
+
+    std::vector<std::size_t> enclosing(std::size(types), 0); // objects of each type on the path from the root
+
+    std::vector<std::pair<std::size_t, bool>> stack { { n, false } };
+
+    while (not stack.empty())
+    {
+      if (auto const [v, visited] = stack.back(); visited)
+      {
+        stack.pop_back();
+
+        if (v < n)
+        {
+          --enclosing[objects[v].type];
+        }
+      }
+      else
+      {
+        stack.back().second = true;
+
+        if (v < n)
+        {
+          auto & s = result[objects[v].type];
+
+          s.count += 1;
+          s.size += objects[v].size;
+
+          if (not enclosing[objects[v].type]++)
+          {
+            s.retained += retained[v];
+          }
+        }
+
+        for (auto w : children[v])
+        {
+          stack.emplace_back(w, false);
+        }
+      }
+    }
+
+    return result;
+  }
+} // namespace memory
+} // namespace meevax